@@ -0,0 +1,59 @@
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Counting operator new/delete, attributed to the subsystem the main loop is
+// in. On by default in HEAPDEBUG device builds and in host builds; the
+// subsystem markers are a single byte store and stay in every build.
+#if !defined(ALLOC_TRACKING) && (defined(HEAPDEBUG) || !defined(ARDUINO))
+#define ALLOC_TRACKING 1
+#endif
+
+class AllocTracker {
+public:
+    enum Subsystem : uint8_t {
+        Other,        // setup, periodic prints, other tasks
+        Network,      // WiFi/WebSocket polling, including the library's frame buffers
+        Parse,        // MtaManager::parseData
+        Arrivals,     // purge, checkArrivals, renderArrivals
+        Render,       // compose and show
+        Diagnostics,  // metrics/history HTTP handlers
+        SubsystemCount
+    };
+
+    // Restores the enclosing subsystem when it goes out of scope.
+    class Scope {
+    public:
+        explicit Scope(Subsystem subsystem) : previous(current) { current = subsystem; }
+        ~Scope() { current = previous; }
+    private:
+        Subsystem previous;
+    };
+
+    static void begin();
+    static void enter(Subsystem subsystem) { current = subsystem; }
+
+    static void noteAlloc(size_t bytes);
+    static void noteFree();
+
+    static uint32_t allocations(Subsystem subsystem);
+    static uint64_t bytes(Subsystem subsystem);
+    static uint32_t liveAllocations();
+    static const char* name(Subsystem subsystem);
+
+    // Arrivals and Render must never allocate once running. Reports (or on
+    // the host, asserts) when their count moves.
+    static void checkSteadyState();
+
+private:
+    static inline Subsystem current = Other;
+    static uint32_t counts[SubsystemCount];
+    static uint64_t byteCounts[SubsystemCount];
+    static uint32_t frees;
+    static uint32_t reportedViolations;
+    static bool baselined;
+};
+
+#endif // ALLOCTRACKER_H
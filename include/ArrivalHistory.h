@@ -0,0 +1,74 @@
+#ifndef ARRIVALHISTORY_H
+#define ARRIVALHISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Total log size. Placed in PSRAM when present; without PSRAM a much smaller
+// internal-RAM log is used so history still works, just over a shorter span.
+#ifndef HISTORY_PSRAM_BYTES
+#define HISTORY_PSRAM_BYTES (768 * 1024)
+#endif
+#ifndef HISTORY_INTERNAL_BYTES
+#define HISTORY_INTERNAL_BYTES (16 * 1024)
+#endif
+#ifndef HISTORY_BLOCK_BYTES
+#define HISTORY_BLOCK_BYTES 1024
+#endif
+
+struct HistoryEvent {
+    uint32_t time;      // scheduled arrival, epoch seconds
+    uint16_t station;   // StationMap index of the station
+    uint8_t route;      // SubwayColorMap route code
+};
+
+// Ring of fixed-size blocks holding bit-packed arrival events, oldest block
+// overwritten first. Each event is a zigzag time delta from the previous
+// event (5, 12 or 34 bits), a 9-bit station and a 5-bit route: about 19 bits
+// for a typical event, so a day of system-wide arrivals fits in PSRAM.
+//
+// Block headers carry the time span, a route mask and a station bloom so
+// queries binary search to the first block in range and skip blocks that
+// cannot match without decoding them.
+class ArrivalHistory {
+public:
+    typedef void (*EventCallback)(const HistoryEvent& event, void* context);
+
+    static bool begin();
+    static void record(uint32_t time, uint16_t station, uint8_t route);
+    static size_t query(uint32_t from, uint32_t to, int station, int route,
+                        EventCallback callback, void* context);
+    static size_t headways(uint16_t station, uint8_t route, uint32_t from, uint32_t to,
+                           uint32_t* out, size_t maxOut);
+
+    static uint32_t eventCount();
+    static size_t bytesUsed();
+    static size_t capacityBytes();
+    static uint32_t oldestTime();
+
+private:
+    struct BlockHeader {
+        uint32_t firstTime;   // time of the first event (delta base)
+        uint32_t minTime;
+        uint32_t maxTime;     // running max across the log, so monotonic by block
+        uint32_t routeMask;
+        uint64_t stationBloom;
+        uint16_t count;
+        uint16_t bitsUsed;
+    };
+
+    static BlockHeader* blockAt(size_t logical);
+    static uint8_t* dataOf(BlockHeader* block);
+    static void startBlock(uint32_t time);
+    static size_t firstBlockFrom(uint32_t from);
+
+    static uint8_t* storage;
+    static size_t blockCount;
+    static size_t head;       // physical index of the block being written
+    static size_t used;       // blocks holding data
+    static uint32_t lastTime;
+    static uint32_t runningMax;
+    static uint32_t totalEvents;
+};
+
+#endif // ARRIVALHISTORY_H
@@ -0,0 +1,56 @@
+#ifndef DISPLAYMODE_H
+#define DISPLAYMODE_H
+
+#include <cstdint>
+
+// How long each route is shown at a station served by several routes when
+// cycling is on.
+#ifndef DISPLAY_CYCLE_MS
+#define DISPLAY_CYCLE_MS 1500
+#endif
+
+// Which routes the arrivals layer shows. The mode is a route-code bitmask
+// ANDed with each station's present-route bitset, so switching modes only
+// re-renders from the bitsets and never walks the train lists.
+//
+// Served on the metrics port:
+//   /mode?routes=A,C,E        routes by ID
+//   /mode?routes=broadway     or by trunk line name
+//   /mode?routes=all&cycle=1  everything, cycling colours at shared stations
+//   /mode?view=heat           trains per hour instead of current arrivals
+class DisplayMode {
+public:
+    static constexpr uint32_t kAllRoutes = 0xFFFFFFFFUL;
+
+    enum View : uint8_t { Arrivals, Heatmap };
+
+    static void begin();
+    static void setFilter(uint32_t routeMask);
+    static void setCycling(bool cycle);
+    static uint32_t filterMask();
+    static bool isCycling();
+    static void setView(View v);
+    static View view();
+
+    // Parses comma separated route IDs and/or line names. Returns 0 if any
+    // token is unknown.
+    static uint32_t parseRoutes(const char* spec);
+
+    // Route code to draw for a station whose visible (filtered) bitset is
+    // non-zero: the lowest code, or the one for the current cycle step.
+    static uint8_t pickRoute(uint32_t visibleRoutes, uint32_t step);
+
+    static uint32_t cycleStep();
+    static bool needsRender();
+    static void markRendered(uint32_t step);
+    static unsigned long msUntilNextCycleStep();
+
+private:
+    static uint32_t filter;
+    static bool cycling;
+    static View current;
+    static bool dirty;
+    static uint32_t renderedStep;
+};
+
+#endif // DISPLAYMODE_H
@@ -0,0 +1,108 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Ring size in records (12 bytes each). Must be a power of two; the ring
+// lives in RTC slow memory, which is 8 KB on the ESP32-S3.
+#ifndef FLIGHT_RECORDER_EVENTS
+#define FLIGHT_RECORDER_EVENTS 256
+#endif
+
+// Loop iterations slower than this are logged.
+#ifndef FLIGHT_SLOW_LOOP_US
+#define FLIGHT_SLOW_LOOP_US 20000
+#endif
+
+// A loop-time sample (mean and max active time) is logged this often.
+#ifndef FLIGHT_LOOP_SAMPLE_MS
+#define FLIGHT_LOOP_SAMPLE_MS 10000
+#endif
+
+// Recent events kept in RTC no-init memory so they survive ESP.restart(),
+// watchdog and panic resets (not power loss). The previous sessions are
+// printed on boot and served at /flightrecorder on the metrics port.
+//
+// log() is a handful of stores into a fixed slot with no locking or
+// formatting, cheap enough to leave on in the hot path.
+class FlightRecorder {
+public:
+    enum Event : uint8_t {
+        Boot,        // arg: esp_reset_reason()
+        Restart,     // arg: RestartCause, value: failed attempts
+        SlowLoop,    // value: active loop time in us
+        Parse,       // arg: stations applied, value: parse time in us
+        ParseError,  // arg: DeserializationError code, value: payload bytes
+        Message,     // value: payload bytes
+        Heap,        // arg: largest free block in KB, value: free bytes
+        Wifi,        // arg: 1 connected, 0 lost
+        WebSocket,   // arg: 1 connected, 0 lost
+        LoopTime,    // arg: mean active loop time in us (capped), value: max in us
+        EventCount
+    };
+
+    enum RestartCause : uint8_t { WifiFailures, WebsocketFailures };
+
+    struct Record {
+        uint32_t timeMs;   // since the boot that logged it
+        uint32_t value;
+        uint16_t arg;
+        uint8_t type;
+        uint8_t boot;      // low bits of the boot count
+    };
+
+    static void begin();
+    static void dump(Print& out);
+    static uint32_t bootCount();
+    static uint8_t resetReason();
+
+    // Call once per loop iteration with its active time. Logs SlowLoop for
+    // slow ones and a LoopTime sample every FLIGHT_LOOP_SAMPLE_MS.
+    static void recordLoop(uint32_t activeUs);
+
+    static inline void log(Event type, uint16_t arg, uint32_t value) {
+        Record& r = ring.records[ring.head++ & (FLIGHT_RECORDER_EVENTS - 1)];
+        r.timeMs = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        r.value = value;
+        r.arg = arg;
+        r.type = type;
+        r.boot = static_cast<uint8_t>(ring.boots);
+    }
+
+private:
+    struct Ring {
+        uint32_t magic;
+        uint32_t boots;
+        uint32_t head;     // free-running; slot is head % FLIGHT_RECORDER_EVENTS
+        Record records[FLIGHT_RECORDER_EVENTS];
+    };
+
+    static_assert((FLIGHT_RECORDER_EVENTS & (FLIGHT_RECORDER_EVENTS - 1)) == 0,
+                  "FLIGHT_RECORDER_EVENTS must be a power of two");
+
+    static size_t format(const Record& record, char* buf, size_t size);
+    static void handleDump();
+
+    // Calls emit(line) for each record still in the ring, oldest first.
+    template <typename F>
+    static void forEachLine(F&& emit) {
+        char line[80];
+        uint32_t end = ring.head;
+        uint32_t start = end > FLIGHT_RECORDER_EVENTS ? end - FLIGHT_RECORDER_EVENTS : 0;
+        for (uint32_t i = start; i < end; ++i) {
+            format(ring.records[i & (FLIGHT_RECORDER_EVENTS - 1)], line, sizeof(line));
+            emit(line);
+        }
+    }
+
+    static Ring ring;
+    static uint8_t lastResetReason;
+    static uint32_t loopWindowStartMs;
+    static uint32_t loopCount;
+    static uint64_t loopSumUs;
+    static uint32_t loopMaxUs;
+};
+
+#endif // FLIGHTRECORDER_H
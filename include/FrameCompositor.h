@@ -0,0 +1,43 @@
+#ifndef FRAMECOMPOSITOR_H
+#define FRAMECOMPOSITOR_H
+
+#include <FastLED.h>
+#include "LEDManager.h"
+
+// Brightness of the base map layer (all station LEDs) under the arrivals.
+// 0 keeps unlit stations dark.
+#ifndef BASE_MAP_LEVEL
+#define BASE_MAP_LEVEL 0
+#endif
+
+// Builds each output frame from separate layers so producers never write
+// the strip buffer directly:
+//
+//   Base      station LEDs scaled by the base map level
+//   Arrivals  lightened over the base (per-channel max)
+//   Status    alpha-blended over everything, e.g. the awaiting-data pattern
+//   Overlay   alpha-blended on top
+class FrameCompositor {
+public:
+    enum Layer : uint8_t { Base, Arrivals, Status, Overlay, LayerCount };
+
+    static CRGB base[NUM_LEDS_SUBWAY];
+    static CRGB arrivals[NUM_LEDS_SUBWAY];
+    static CRGB status[NUM_LEDS_SUBWAY];
+    static CRGB overlay[NUM_LEDS_SUBWAY];
+
+    static void initialize();
+    static void setEnabled(Layer layer, bool enabled);
+    static bool isEnabled(Layer layer);
+    static void setBaseLevel(uint8_t level);
+    static void setStatusAlpha(uint8_t alpha);
+    static void setOverlayAlpha(uint8_t alpha);
+    static void compose(CRGB* out, size_t count);
+private:
+    static bool enabled[LayerCount];
+    static uint8_t baseLevel;
+    static uint8_t statusAlpha;
+    static uint8_t overlayAlpha;
+};
+
+#endif // FRAMECOMPOSITOR_H
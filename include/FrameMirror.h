@@ -0,0 +1,54 @@
+#ifndef FRAMEMIRROR_H
+#define FRAMEMIRROR_H
+
+#include <Arduino.h>
+#include "LEDManager.h"
+#include "MirrorCodec.h"
+
+// Upper bound on frames sent per second. Frames in between are folded into
+// the next diff, which is always against the last frame sent.
+#ifndef MIRROR_MAX_FPS
+#define MIRROR_MAX_FPS 10
+#endif
+
+// A key frame is sent at least this often, so a viewer that joins or drops
+// a frame resyncs.
+#ifndef MIRROR_KEYFRAME_MS
+#define MIRROR_KEYFRAME_MS 10000
+#endif
+
+// Streams LEDManager::leds back to the feed server as binary WebSocket
+// messages in MirrorCodec format, so a remote viewer can see what the map
+// shows. Off until the server sends {"mirror":1} and turned off again when
+// the connection drops, so it costs nothing unless someone is watching.
+class FrameMirror {
+public:
+    // Applies a {"mirror":0|1} control message. Returns false if the payload
+    // isn't one.
+    static bool handleMessage(const char* payload, size_t length);
+    static void setEnabled(bool on);
+    static bool isEnabled();
+
+    // Encodes the current frame if it is time to send one and it changed.
+    // Returns the bytes to send, or 0. The data stays valid until the next call.
+    static size_t encode(const CRGB* leds);
+    static const uint8_t* data();
+
+    // Reports whether data() was sent. Only a sent frame becomes the base
+    // for the next diff and advances the sequence; after a failure the next
+    // frame is a key frame, since the viewer may have missed anything.
+    static void commit(bool delivered);
+
+private:
+    static bool enabled;
+    static bool keyPending;
+    static uint16_t sequence;
+    static unsigned long lastSentMs;
+    static unsigned long lastKeyMs;
+    static const CRGB* encoded;     // frame behind data(), until commit()
+    static size_t encodedLength;
+    static CRGB sent[NUM_LEDS_SUBWAY];
+    static uint8_t buffer[MirrorCodec::maxEncodedBytes(NUM_LEDS_SUBWAY)];
+};
+
+#endif // FRAMEMIRROR_H
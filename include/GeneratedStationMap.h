@@ -3,17 +3,26 @@
 
 /**
  * Auto-generated station map header file
- * Generated on: 2025-09-27 14:23:37
+ * Generated on: 2026-10-19 06:01:44
  *
- * IMPORTANT: Only declares the stationMap symbol.
- * The definition is generated in src/GeneratedStationMap.cpp to avoid
- * duplicate copies across translation units.
+ * Compiled-in station layout, used when no station map image is flashed.
+ * One station per feed stop ID, sorted by ID. The LEDs of station i are
+ * generatedStationLeds[generatedStationLedStart[i] .. generatedStationLedStart[i + 1]);
+ * generatedLedComplex gives each LED's parent complex (0xFFFF for spacers).
  */
 
-#include <string>
-#include <map>
-#include "Station.h"
+#include <cstdint>
 
-extern std::map<int, Station> stationMap;
+#define GENERATED_STATION_COUNT 442
+#define GENERATED_FANOUT_COUNT 454
+#define GENERATED_LED_COUNT 455
+#define GENERATED_COMPLEX_COUNT 431
+
+extern const char* const generatedStationIds[GENERATED_STATION_COUNT];
+extern const char* const generatedStationNames[GENERATED_STATION_COUNT];
+extern const uint16_t generatedStationLedStart[GENERATED_STATION_COUNT + 1];
+extern const uint16_t generatedStationLeds[GENERATED_FANOUT_COUNT];
+extern const uint16_t generatedLedComplex[GENERATED_LED_COUNT];
+extern const char generatedComplexIds[GENERATED_COMPLEX_COUNT][4];
 
 #endif // STATION_MAP_H
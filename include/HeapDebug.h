@@ -2,6 +2,8 @@
 #define HEAPDEBUG_H
 
 #include <Arduino.h>
+#include "AllocTracker.h"
+#include "MemoryPolicy.h"
 
 class HeapDebug {
 public:
@@ -23,6 +25,26 @@ public:
         static_cast<unsigned long>(usedHeap / 1024),
         usedPercentOfHeap,
         static_cast<unsigned long>(freeHeap / 1024));
+    Serial.printf(
+        "[Heap] Largest free block: %lu KB, Min ever free: %lu KB\n",
+        static_cast<unsigned long>(ESP.getMaxAllocHeap() / 1024),
+        static_cast<unsigned long>(ESP.getMinFreeHeap() / 1024));
+    Serial.printf(
+        "[Heap] PSRAM free: %lu KB, largest block: %lu KB, fallbacks to internal: %lu\n",
+        static_cast<unsigned long>(MemoryPolicy::freeBytes(MemoryPolicy::External) / 1024),
+        static_cast<unsigned long>(MemoryPolicy::largestFreeBlock(MemoryPolicy::External) / 1024),
+        static_cast<unsigned long>(MemoryPolicy::fallbacks()));
+#if ALLOC_TRACKING
+    for (uint8_t i = 0; i < AllocTracker::SubsystemCount; ++i) {
+      auto subsystem = static_cast<AllocTracker::Subsystem>(i);
+      Serial.printf("[Heap] %-12s %8lu allocs %10llu bytes\n",
+                    AllocTracker::name(subsystem),
+                    static_cast<unsigned long>(AllocTracker::allocations(subsystem)),
+                    static_cast<unsigned long long>(AllocTracker::bytes(subsystem)));
+    }
+    Serial.printf("[Heap] live allocations: %lu\n",
+                  static_cast<unsigned long>(AllocTracker::liveAllocations()));
+#endif
 }
 };
 
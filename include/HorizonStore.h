@@ -0,0 +1,136 @@
+#ifndef HORIZONSTORE_H
+#define HORIZONSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+// How far ahead arrivals are kept for outages. Matches MTAPI's MAX_MINUTES.
+#ifndef HORIZON_SECONDS
+#define HORIZON_SECONDS 1800
+#endif
+
+// Shared pool size in entries (2 bytes each). MTAPI sends at most
+// MAX_TRAINS = 10 per direction, so 20 per station covers every station.
+#ifndef HORIZON_CAPACITY
+#define HORIZON_CAPACITY 12288
+#endif
+
+// Cap per station, to keep one noisy station from draining the pool.
+#ifndef HORIZON_MAX_PER_STATION
+#define HORIZON_MAX_PER_STATION 48
+#endif
+
+// A (station, feed) run of the shared pool. Entries [start, start + count)
+// are sorted; those before cursor are already in the live train list.
+struct HorizonSlot {
+    uint16_t start;
+    uint8_t count;
+    uint8_t capacity;
+    uint8_t cursor;
+};
+
+// Compact 30-minute schedule kept alongside the live 5-minute window, so the
+// map keeps running from the last known predictions when the feed drops.
+//
+// Each entry is a uint16: seconds since a shared epoch in the top 11 bits and
+// the route code in the low 5, so a run sorts by time. The epoch trails the
+// clock and is rebased every few minutes, which keeps 11 bits (34 minutes)
+// enough for the horizon. Each station holds one variable-length run per
+// feed that has listed it, so a record from one feed never disturbs another
+// feed's predictions. Runs share one fixed pool; a run that outgrows its
+// space moves to the end, and the pool is compacted in place when the end is
+// reached. Stations are addressed by their index in StationMap::stations.
+class HorizonStore {
+public:
+    static constexpr uint8_t kRouteBits = 5;
+    static constexpr uint32_t kMaxOffset = (1U << (16 - kRouteBits)) - 1;
+    // Feeds per station; a station's feeds with a run are a uint8_t bitmask.
+    static constexpr uint8_t kMaxFeeds = 8;
+
+    // Trains collected from one station record, before replace().
+    struct Batch {
+        uint16_t entries[HORIZON_MAX_PER_STATION];
+        uint8_t count = 0;
+        bool add(time_t arrival, uint8_t route);
+    };
+
+    // Call once the station map is loaded.
+    static void begin();
+
+    // Rebases the epoch if it has fallen too far behind now. Call before
+    // filling a Batch so its offsets stay valid through replace().
+    static void advance(time_t now);
+
+    // Replaces one feed's run for a station with the batch, leaving the
+    // station's other feeds alone. Entries already inside the live window
+    // (before liveUntil) are marked as promoted.
+    static void replace(size_t station, uint8_t feed, Batch& batch, time_t liveUntil);
+
+    // Calls add(route, arrivalTime, feed) for each stored train up to until
+    // that has not been handed out yet. Ordered by time within each feed.
+    template <typename F>
+    static void promote(size_t station, time_t until, F&& add) {
+        for (uint8_t feeds = feedMask[station]; feeds; feeds &= feeds - 1) {
+            uint8_t feed = static_cast<uint8_t>(__builtin_ctz(feeds));
+            HorizonSlot& run = slots[station * kMaxFeeds + feed];
+            while (run.cursor < run.count) {
+                uint16_t entry = pool[run.start + run.cursor];
+                time_t arrival = timeOf(entry);
+                if (arrival > until) break;
+                add(static_cast<uint8_t>(entry & ((1U << kRouteBits) - 1)), arrival, feed);
+                run.cursor++;
+            }
+        }
+    }
+
+    // Arrival time of the station's next entry not yet promoted, over all
+    // its feeds, or 0 if none.
+    static time_t nextPending(size_t station);
+
+    // Entries promote() has yet to hand out for the station.
+    static size_t pendingCount(size_t station);
+
+    // Whether any feed holds entries for the station.
+    static bool holds(size_t station) { return feedMask[station] != 0; }
+
+    // Bitset of routes with a stored arrival in [t - window, t], promoted or
+    // not, over all the station's feeds. Binary searches each run, so it is
+    // cheap enough to call for every station each frame. Reads only.
+    static uint32_t routesAt(size_t station, time_t t, time_t window);
+
+    static size_t used();
+    static uint32_t dropped();
+
+#ifndef ARDUINO
+    // Host inspection: one feed's run, and visit(route, arrivalTime) for
+    // each of its entries, promoted or not.
+    static const HorizonSlot& slot(size_t station, uint8_t feed) { return slots[station * kMaxFeeds + feed]; }
+    template <typename F>
+    static void forEach(size_t station, uint8_t feed, F&& visit) {
+        const HorizonSlot& run = slot(station, feed);
+        for (uint8_t i = 0; i < run.count; ++i) {
+            uint16_t entry = pool[run.start + i];
+            visit(static_cast<uint8_t>(entry & ((1U << kRouteBits) - 1)), timeOf(entry));
+        }
+    }
+#endif
+
+private:
+    static time_t timeOf(uint16_t entry) { return epoch + (entry >> kRouteBits); }
+    static void rebase(time_t newEpoch);
+    static void compact();
+
+    static uint16_t* pool;      // PSRAM when present
+    static size_t capacity;
+    static HorizonSlot* slots;  // stations x kMaxFeeds, with the pool
+    static uint8_t* feedMask;   // per station, feeds whose run is non-empty
+    static size_t slotCount;
+    static uint16_t* order;     // slot indices, scratch for compact()
+    static size_t end;          // first free pool entry
+    static size_t live;         // entries held across all stations
+    static uint32_t droppedEntries;
+    static time_t epoch;
+};
+
+#endif // HORIZONSTORE_H
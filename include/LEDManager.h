@@ -12,6 +12,27 @@
 #define NUM_LEDS_ERROR 2
 #define DATA_PIN_ERROR 5  // D2
 
+// Push frames from a separate task so the loop doesn't block for the ~15 ms
+// a 500-pixel WS2812B transfer takes. Experimental and unmeasured on
+// hardware, so off by default; build with 1 to try it.
+#ifndef LED_ASYNC_SHOW
+#define LED_ASYNC_SHOW 0
+#endif
+
+// The show task runs on the loop's core, above it in priority, so it must
+// never spin: it would starve the loop for the whole transfer. FastLED's
+// ESP32 RMT driver refills the channel from its interrupt and waits for the
+// end of the transfer in xSemaphoreTake(portMAX_DELAY), which blocks. The
+// only busy-wait in FastLED.show() is the refresh-rate limit, which
+// initializeLEDs() turns off in this mode. Keeping the task on the loop's
+// core also keeps any interrupt masking off the core running WiFi.
+#ifndef LED_SHOW_CORE
+#define LED_SHOW_CORE ARDUINO_RUNNING_CORE
+#endif
+#ifndef LED_SHOW_PRIORITY
+#define LED_SHOW_PRIORITY 2
+#endif
+
 class LEDManager {
 public:
     static CRGB leds[NUM_LEDS_SUBWAY];
@@ -19,5 +40,20 @@ public:
     static void initializeLEDs();
     static void show();
     static void awaitingDataSequence();
+    static void clearAwaitingSequence();
+    static unsigned long msUntilNextAwaitingStep();
+    static void setConnectionStatus(bool wifiConnected, bool websocketConnected);
+private:
+    static void present();
+#if LED_ASYNC_SHOW
+    static void showTask(void* arg);
+#endif
+
+    // Last frame handed to the strip. With LED_ASYNC_SHOW these are the
+    // buffers FastLED clocks out; leds/errorLeds are the back buffers the
+    // loop composes into while a transfer is in flight.
+    static CRGB shownLeds[NUM_LEDS_SUBWAY];
+    static CRGB shownErrorLeds[NUM_LEDS_ERROR];
+    static bool hasShown;
 };
 #endif // LEDMANAGER_H
\ No newline at end of file
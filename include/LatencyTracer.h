@@ -0,0 +1,65 @@
+#ifndef LATENCYTRACER_H
+#define LATENCYTRACER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Metrics.h"
+
+// Follows each feed message from the upstream feed to the first frame shown
+// after it. The server puts trace fields ahead of "data":
+//
+//   {"msg_id":812,"feed_ms":1727461410000,"sent_ms":1727461417250,"data":[...]}
+//
+// feed_ms is the upstream feed timestamp and sent_ms the broadcast time, both
+// epoch milliseconds; any of the three may be absent. Stages:
+//
+//   Feed     feed_ms -> sent_ms      time the server held the snapshot
+//   Network  sent_ms -> received     needs NTP-synced clocks on both ends
+//   Parse    received -> parsed      MtaManager::parseData()
+//   Render   parsed -> shown         checkArrivals, compose and hand-off to the strip
+//                                    (plus the transfer itself without LED_ASYNC_SHOW)
+//   Total    feed_ms (or sent_ms) -> shown
+class LatencyTracer {
+public:
+    enum Stage : uint8_t { Feed, Network, Parse, Render, Total, StageCount };
+
+    static void received();
+    static void readHeader(const char* header, size_t length);
+    static void parsed();
+    static void shown();
+
+    static const LatencyHistogram& histogram(Stage stage);
+    static const char* stageName(Stage stage);
+    static uint32_t lastMessageId();
+    static uint32_t missedMessages();
+    static uint32_t clockSkewSamples();
+
+    // sent_ms of the message being parsed (0 if absent) and the micros()
+    // at which it arrived, for TimeManager.
+    static int64_t serverTimeMs();
+    static uint32_t receivedAtUs();
+
+private:
+    struct Trace {
+        bool active;
+        bool parsed;
+        uint32_t msgId;
+        int64_t feedMs;
+        int64_t sentMs;
+        int64_t receivedMs;   // wall clock, 0 if not yet synced
+        uint32_t receivedUs;
+        uint32_t parsedUs;
+    };
+
+    static int64_t wallClockMs();
+    static int64_t headerNumber(const char* header, size_t length, const char* key);
+    static void recordWall(Stage stage, int64_t fromMs, int64_t toMs);
+
+    static Trace trace;
+    static LatencyHistogram histograms[StageCount];
+    static uint32_t lastId;
+    static uint32_t missed;
+    static uint32_t skewed;
+};
+
+#endif // LATENCYTRACER_H
@@ -0,0 +1,87 @@
+#ifndef LEDKERNELS_H
+#define LEDKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Bulk pixel kernels over packed 8-bit RGB buffers (CRGB arrays viewed as
+// bytes). Kept free of Arduino/FastLED so they build on the host for
+// benchmarking.
+//
+// On the host the plain byte loops are written to auto-vectorize (SSE2/AVX2
+// or NEON at -O3). GCC does not vectorize for the ESP32-S3's PIE extension, so
+// device builds use a word-wide SWAR path instead: two 8-bit lanes per 16-bit
+// half of a 32-bit word, with headroom for the 8x9-bit products.
+#if !defined(LED_KERNELS_SWAR) && defined(ARDUINO_ARCH_ESP32)
+#define LED_KERNELS_SWAR 1
+#endif
+
+class LedKernels {
+public:
+    // Sets every pixel to (r, g, b). Writes one pixel, then doubles the filled
+    // span with memcpy so the bulk of the work is a vectorized copy.
+    static void fill(uint8_t* dst, size_t pixels, uint8_t r, uint8_t g, uint8_t b) {
+        if (pixels == 0) return;
+        const size_t total = pixels * 3;
+        dst[0] = r;
+        dst[1] = g;
+        dst[2] = b;
+        size_t filled = 3;
+        while (filled < total) {
+            size_t n = (filled <= total - filled) ? filled : total - filled;
+            memcpy(dst + filled, dst, n);
+            filled += n;
+        }
+    }
+
+    // dst = dst * scale / 256, with 255 leaving the buffer unchanged.
+    static void scale(uint8_t* dst, size_t bytes, uint8_t scale) {
+        const uint32_t s = static_cast<uint32_t>(scale) + 1;
+        size_t i = 0;
+#if LED_KERNELS_SWAR
+        for (; i + 4 <= bytes; i += 4) {
+            uint32_t w;
+            memcpy(&w, dst + i, 4);
+            uint32_t lo = (((w & 0x00FF00FFUL) * s) >> 8) & 0x00FF00FFUL;
+            uint32_t hi = (((w >> 8) & 0x00FF00FFUL) * s) & 0xFF00FF00UL;
+            w = lo | hi;
+            memcpy(dst + i, &w, 4);
+        }
+#endif
+        for (; i < bytes; ++i) {
+            dst[i] = static_cast<uint8_t>((dst[i] * s) >> 8);
+        }
+    }
+
+    // dst = max(dst, src) per channel. Used to lay bright layers over a dim
+    // base without washing the base colour into them.
+    static void lighten(uint8_t* __restrict dst, const uint8_t* __restrict src, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) {
+            dst[i] = dst[i] > src[i] ? dst[i] : src[i];
+        }
+    }
+
+    // dst = dst + (src - dst) * alpha / 255 (approximately; 0 keeps dst, 255 gives src).
+    static void blend(uint8_t* __restrict dst, const uint8_t* __restrict src, size_t bytes, uint8_t alpha) {
+        const uint32_t a = static_cast<uint32_t>(alpha) + (alpha >> 7);
+        const uint32_t ia = 256 - a;
+        size_t i = 0;
+#if LED_KERNELS_SWAR
+        for (; i + 4 <= bytes; i += 4) {
+            uint32_t d, s;
+            memcpy(&d, dst + i, 4);
+            memcpy(&s, src + i, 4);
+            uint32_t lo = ((((d & 0x00FF00FFUL) * ia) + ((s & 0x00FF00FFUL) * a)) >> 8) & 0x00FF00FFUL;
+            uint32_t hi = ((((d >> 8) & 0x00FF00FFUL) * ia) + (((s >> 8) & 0x00FF00FFUL) * a)) & 0xFF00FF00UL;
+            d = lo | hi;
+            memcpy(dst + i, &d, 4);
+        }
+#endif
+        for (; i < bytes; ++i) {
+            dst[i] = static_cast<uint8_t>((dst[i] * ia + src[i] * a) >> 8);
+        }
+    }
+};
+
+#endif // LEDKERNELS_H
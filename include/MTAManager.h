@@ -2,24 +2,98 @@
 #define MTAMANAGER_H
 
 #include <string>
+#include <vector>
 #include <ArduinoJson.h>
-#include <ArduinoWebsockets.h>
+#include "HorizonStore.h"
+#include "MemoryPolicy.h"
 #include "Station.h"
 #include "SubwayColors.h"
 
+// Capacity of the parse document's pool, allocated in PSRAM.
+#ifndef MTA_JSON_DOC_BYTES
+#define MTA_JSON_DOC_BYTES (200 * 1024)
+#endif
+
+// Train list capacity reserved per station by begin(), so updates don't
+// reallocate. Covers the 5-minute look-ahead at the busiest stations; the
+// lists live in internal RAM, about 442 x 12 x sizeof(Train).
+#ifndef MTA_TRAINS_PER_STATION
+#define MTA_TRAINS_PER_STATION 12
+#endif
+
+// Feed IDs a message may tag its station records with (0 .. MTA_MAX_FEEDS-1).
+#ifndef MTA_MAX_FEEDS
+#define MTA_MAX_FEEDS 8
+#endif
+
 class MtaManager {
 public:
-    static void parseData(websockets::WebsocketsMessage msg);
+    // Trains closer than this are in the live list; later ones wait in the
+    // horizon store until they come into range.
+    static constexpr int kLookAheadSeconds = 300;
+
+    // One station's arrivals for both directions, as decoded from any
+    // ingestion format. Decoders fill this and hand it to
+    // applyStationUpdate(); nothing else writes train lists.
+    struct StationUpdate {
+        struct Arrival {
+            time_t time;
+            uint8_t route;
+            uint8_t direction;  // Train::Direction
+            bool arrived;       // reschedules a train that already arrived
+        };
+
+        uint8_t feed = 0;
+        uint32_t generation = 0;  // 0: untagged, always applied
+        uint8_t directions = 0;   // bit per Train::Direction listed, even if empty
+        uint8_t count = 0;
+        Arrival arrivals[HORIZON_MAX_PER_STATION];
+
+        bool add(Train::Direction direction, uint8_t route, time_t time) {
+            if (count >= HORIZON_MAX_PER_STATION) return false;
+            arrivals[count++] = {time, route, static_cast<uint8_t>(direction), false};
+            return true;
+        }
+    };
+
+    static void begin();
+    static void parseData(char* payload, size_t length);
     static void checkArrivals();
-    static Station* findStationById(const std::string& id);
+    static void renderArrivals();
+    static uint32_t routesAt(const Station& station, time_t t);
     static void purgeExpiredTrains();
-    static void addNewTrains(Station& station, JsonArray arr);
-    static void handleStationUpdate(JsonObject stationObj, time_t now);
+    static bool applyStationUpdate(Station& station, StationUpdate& update, time_t now, time_t* admitAt);
+    static time_t handleStationUpdate(JsonObject stationObj, time_t now, int feed, uint32_t generation);
+    static void resetGenerations();
+    static uint32_t stationDigest(JsonObject stationObj, uint8_t feed);
     static bool isAnyTrainPresent();
     static bool hasAnyTrainData();
+    static bool isRefreshDue();
+    static unsigned long msUntilNextChange();
 private:
+    static bool isStale(uint8_t feed, uint32_t generation);
+
     static SubwayColorMap colorMap;
-    static inline DynamicJsonDocument doc{200 * 1024};
+    using ParseDocument = BasicJsonDocument<SpiRamAllocator>;
+
+    static inline bool refreshPending = true;
+    static inline time_t nextChangeTime = 0;
+    static inline uint32_t lastPayloadHash = 0;
+    static inline size_t lastPayloadLength = 0;
+    static inline time_t payloadExpires = 0;
+    // Parsed in place: string values point into the payload passed to
+    // parseData(), so the document is only valid for the duration of that call.
+    // Created in begin(), once PSRAM is up.
+    static inline ParseDocument* doc = nullptr;
+    // Newest generation applied per feed; bit n of feedsSeen is set once feed n
+    // has sent one. Cleared on reconnect, since the server may have restarted.
+    static inline uint32_t feedGeneration[MTA_MAX_FEEDS] = {};
+    static inline uint8_t feedsSeen = 0;
+    // Output of applyStationUpdate()'s merge, copied back over the station's
+    // list. Kept across calls so steady state doesn't allocate.
+    static inline std::vector<Train> merged;
+    static_assert(MTA_MAX_FEEDS <= 8, "feedsSeen is a uint8_t bitmask");
+    static_assert(MTA_MAX_FEEDS <= HorizonStore::kMaxFeeds, "HorizonStore keeps a run per feed");
 };
 
 #endif // MTAMANAGER_H
\ No newline at end of file
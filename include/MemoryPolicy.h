@@ -0,0 +1,84 @@
+#ifndef MEMORYPOLICY_H
+#define MEMORYPOLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Plain malloc()/new requests at least this large go to PSRAM once begin()
+// has run. That covers buffers we don't allocate ourselves, like the
+// WebSocket library's receive payloads. WiFi and lwIP ask for internal memory
+// explicitly and are unaffected.
+#ifndef PSRAM_MALLOC_THRESHOLD
+#define PSRAM_MALLOC_THRESHOLD 4096
+#endif
+
+// Where large buffers live. Internal SRAM is shared with the WiFi stack, so
+// only memory touched every frame stays there:
+//
+//   External (PSRAM)  JSON parse document, receive payloads, arrival history,
+//                     horizon store
+//   Internal          LED and layer buffers, station table, colour tables
+//
+// External requests fall back to internal memory when there is no PSRAM or
+// it is full; fallbacks() counts them. Host builds simulate both heaps with
+// fixed budgets so placement can be checked off-device.
+class MemoryPolicy {
+public:
+    enum Tier : uint8_t { Internal, External, TierCount };
+
+    static void begin();
+    static bool hasExternal();
+
+    static void* allocate(size_t bytes, Tier tier);
+    static void* reallocate(void* ptr, size_t bytes, Tier tier);
+    static void release(void* ptr);
+
+    static size_t freeBytes(Tier tier);
+    static size_t largestFreeBlock(Tier tier);
+    static uint32_t fallbacks();
+    static const char* name(Tier tier);
+
+#ifndef ARDUINO
+    // Host shim. Budgets default to the Nano ESP32's ~320 KB heap and 8 MB
+    // PSRAM; an external budget of 0 simulates a board without PSRAM.
+    static void simulate(size_t internalBytes, size_t externalBytes);
+    static Tier tierOf(const void* ptr);
+    static size_t usedBytes(Tier tier);
+#endif
+
+private:
+    static uint32_t fallbackCount;
+};
+
+// ArduinoJson allocator for BasicJsonDocument: keeps parse documents in PSRAM.
+struct SpiRamAllocator {
+    void* allocate(size_t size) { return MemoryPolicy::allocate(size, MemoryPolicy::External); }
+    void deallocate(void* ptr) { MemoryPolicy::release(ptr); }
+    void* reallocate(void* ptr, size_t size) { return MemoryPolicy::reallocate(ptr, size, MemoryPolicy::External); }
+};
+
+// STL allocator that pins a container to internal RAM regardless of its
+// size, for tables read on every frame.
+template <typename T>
+struct InternalAllocator {
+    using value_type = T;
+
+    InternalAllocator() = default;
+    template <typename U>
+    InternalAllocator(const InternalAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* p = MemoryPolicy::allocate(n * sizeof(T), MemoryPolicy::Internal);
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t) { MemoryPolicy::release(p); }
+
+    template <typename U>
+    bool operator==(const InternalAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const InternalAllocator<U>&) const { return false; }
+};
+
+#endif // MEMORYPOLICY_H
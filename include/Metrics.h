@@ -0,0 +1,105 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+#ifndef METRICS_PORT
+#define METRICS_PORT 9100
+#endif
+
+// Running sum/count/max of a duration in microseconds, exported as a
+// Prometheus summary without quantiles plus a max gauge.
+struct DurationStat {
+    uint64_t sumUs = 0;
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+
+    void record(uint32_t us) {
+        sumUs += us;
+        count++;
+        if (us > maxUs) maxUs = us;
+    }
+};
+
+// Cumulative latency histogram with fixed bucket bounds, exported as a
+// Prometheus histogram.
+struct LatencyHistogram {
+    static constexpr uint8_t kBuckets = 15;
+    static constexpr uint32_t kBoundsUs[kBuckets] = {
+        1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+        1000000, 2500000, 5000000, 10000000, 30000000, 60000000
+    };
+
+    uint32_t buckets[kBuckets + 1] = {};  // last is +Inf
+    uint64_t sumUs = 0;
+    uint32_t count = 0;
+
+    void record(uint32_t us) {
+        uint8_t i = 0;
+        while (i < kBuckets && us > kBoundsUs[i]) i++;
+        buckets[i]++;
+        sumUs += us;
+        count++;
+    }
+};
+
+// Formats Prometheus text into a fixed staging buffer and hands each full
+// chunk to a sink, so the exposition can outgrow any single buffer.
+class MetricsWriter {
+public:
+    typedef void (*Sink)(const char* data, size_t length, void* context);
+
+    MetricsWriter(char* buf, size_t size, Sink sink, void* context);
+    void printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void flush();
+
+    void counter(const char* name, const char* help, unsigned long long value);
+    void gauge(const char* name, const char* help, unsigned long long value);
+    void signedGauge(const char* name, const char* help, long long value);
+    void ratio(const char* name, const char* help, uint32_t part, uint32_t total);
+    void duration(const char* name, const char* help, const DurationStat& stat);
+    void histogram(const char* name, const char* stage, const LatencyHistogram& hist);
+
+private:
+    char* buf;
+    size_t size;
+    size_t len;
+    Sink sink;
+    void* context;
+};
+
+// Pipeline counters served as Prometheus text on http://<device>:METRICS_PORT/metrics.
+// Updates are plain integer increments so they stay enabled in production.
+class Metrics {
+public:
+    static void begin();
+    static void poll();
+    static void render(MetricsWriter& out);
+    static WebServer& server();
+
+    static inline uint32_t messagesReceived = 0;
+    static inline uint64_t bytesReceived = 0;
+    static inline uint32_t parseErrors = 0;
+    static inline uint32_t messagesSkipped = 0;
+    static inline uint32_t stationsSkipped = 0;
+    static inline uint32_t stationsUpdated = 0;
+    static inline uint32_t stationsRejected = 0;
+    static inline uint32_t trainsAdded = 0;
+    static inline uint32_t trainsReplaced = 0;
+    static inline uint32_t trainsOutOfWindow = 0;
+    static inline uint32_t trainsPurged = 0;
+    static inline uint32_t trainsPromoted = 0;
+    static inline uint32_t wifiReconnects = 0;
+    static inline uint32_t websocketReconnects = 0;
+    static inline uint32_t mirrorFrames = 0;
+    static inline uint64_t mirrorBytes = 0;
+
+    static inline DurationStat parseTime;
+    static inline DurationStat loopTime;
+    static inline DurationStat showTime;          // loop time spent presenting a frame
+    static inline DurationStat showTransferTime;  // strip clock-out time per frame; one frame late with LED_ASYNC_SHOW
+    static inline DurationStat mirrorEncodeTime;
+};
+
+#endif // METRICS_H
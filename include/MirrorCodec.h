@@ -0,0 +1,196 @@
+#ifndef MIRRORCODEC_H
+#define MIRRORCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Wire format for the LED mirror stream. Kept free of Arduino/FastLED so the
+// host viewer in tools/feedsim decodes with the same code.
+//
+// A frame is a diff against the previous frame sent (a key frame against all
+// black):
+//
+//   flags:u8  seq:u16le  pixels:u16le
+//   [palette mode]  colours:u8  colours * {r, g, b}
+//   runs until pixels are covered:  skip:varint  literals:varint  literals * pixel
+//
+// Pixels are 3 bytes RGB, or 1 byte palette index in palette mode. Counts are
+// LEB128 varints, so an idle span of the strip costs one or two bytes.
+// Unchanged pixels after the last literal are implied.
+class MirrorCodec {
+public:
+    static constexpr uint8_t kKeyFrame = 0x01;
+    static constexpr uint8_t kPalette = 0x02;
+    static constexpr size_t kHeaderBytes = 5;
+    static constexpr size_t kMaxPalette = 64;
+
+    // Output buffer size that always fits a frame of this many pixels: the
+    // worst case alternates changed and unchanged pixels.
+    static constexpr size_t maxEncodedBytes(size_t pixels) {
+        return kHeaderBytes + 1 + kMaxPalette * 3 + pixels * 3 + (pixels / 2 + 1) * 6;
+    }
+
+    // Encodes cur against prev (nullptr for a key frame). Uses palette mode
+    // when the changed pixels have few enough colours for it to be smaller.
+    // Returns the bytes written, or 0 if nothing changed and no key frame was
+    // asked for.
+    static size_t encode(const uint8_t* cur, const uint8_t* prev, size_t pixels, uint16_t seq, uint8_t* out) {
+        static const uint8_t kBlack[3] = {0, 0, 0};
+        Palette palette;
+        size_t literals = 0;
+        for (size_t i = 0; i < pixels; ++i) {
+            const uint8_t* p = prev ? &prev[i * 3] : kBlack;
+            if (memcmp(&cur[i * 3], p, 3) == 0) continue;
+            literals++;
+            if (palette.count <= kMaxPalette) palette.insert(&cur[i * 3]);
+        }
+        if (literals == 0 && prev) return 0;
+
+        const bool indexed = palette.count <= kMaxPalette && 1 + palette.count * 3 + literals < literals * 3;
+        uint8_t* o = out;
+        *o++ = static_cast<uint8_t>((prev ? 0 : kKeyFrame) | (indexed ? kPalette : 0));
+        *o++ = static_cast<uint8_t>(seq);
+        *o++ = static_cast<uint8_t>(seq >> 8);
+        *o++ = static_cast<uint8_t>(pixels);
+        *o++ = static_cast<uint8_t>(pixels >> 8);
+        if (indexed) {
+            *o++ = static_cast<uint8_t>(palette.count);
+            memcpy(o, palette.colours, palette.count * 3);
+            o += palette.count * 3;
+        }
+
+        size_t i = 0;
+        while (i < pixels) {
+            size_t start = i;
+            while (i < pixels && memcmp(&cur[i * 3], prev ? &prev[i * 3] : kBlack, 3) == 0) i++;
+            if (i == pixels) break;
+            size_t skip = i - start;
+            start = i;
+            while (i < pixels && memcmp(&cur[i * 3], prev ? &prev[i * 3] : kBlack, 3) != 0) i++;
+            o = putVarint(o, skip);
+            o = putVarint(o, i - start);
+            for (size_t j = start; j < i; ++j) {
+                if (indexed) {
+                    *o++ = palette.find(&cur[j * 3]);
+                } else {
+                    memcpy(o, &cur[j * 3], 3);
+                    o += 3;
+                }
+            }
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    // Strip length a frame was encoded for, or 0 if it is too short to say.
+    static size_t framePixels(const uint8_t* in, size_t length) {
+        return length < kHeaderBytes ? 0 : static_cast<size_t>(in[3] | (in[4] << 8));
+    }
+
+    // Applies one frame to pixels (count * 3 bytes), clearing them first for a
+    // key frame. Returns false if the frame is malformed or sized for a
+    // different strip; pixels may then be partly updated.
+    static bool decode(const uint8_t* in, size_t length, uint8_t* pixels, size_t count, uint8_t* flags, uint16_t* seq) {
+        if (length < kHeaderBytes) return false;
+        const uint8_t* end = in + length;
+        *flags = in[0];
+        *seq = static_cast<uint16_t>(in[1] | (in[2] << 8));
+        size_t total = static_cast<size_t>(in[3] | (in[4] << 8));
+        if (total != count) return false;
+        in += kHeaderBytes;
+
+        const uint8_t* colours = nullptr;
+        size_t colourCount = 0;
+        if (*flags & kPalette) {
+            if (in >= end) return false;
+            colourCount = *in++;
+            if (static_cast<size_t>(end - in) < colourCount * 3) return false;
+            colours = in;
+            in += colourCount * 3;
+        }
+        if (*flags & kKeyFrame) memset(pixels, 0, count * 3);
+
+        size_t i = 0;
+        while (in < end) {
+            size_t skip, literals;
+            if (!getVarint(in, end, &skip) || !getVarint(in, end, &literals)) return false;
+            if (skip > count - i || literals > count - i - skip) return false;
+            i += skip;
+            size_t bytes = literals * (colours ? 1 : 3);
+            if (static_cast<size_t>(end - in) < bytes) return false;
+            for (size_t j = 0; j < literals; ++j, ++i) {
+                if (colours) {
+                    if (*in >= colourCount) return false;
+                    memcpy(&pixels[i * 3], &colours[*in++ * 3], 3);
+                } else {
+                    memcpy(&pixels[i * 3], in, 3);
+                    in += 3;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    // Open-addressed colour table; count goes past kMaxPalette once it
+    // overflows and palette mode is off for the frame.
+    struct Palette {
+        static constexpr size_t kSlots = 128;
+        uint32_t keys[kSlots] = {};  // colour + 1, 0 = empty
+        uint8_t index[kSlots];
+        uint8_t colours[kMaxPalette * 3];
+        size_t count = 0;
+
+        static uint32_t keyOf(const uint8_t* rgb) {
+            return ((static_cast<uint32_t>(rgb[0]) << 16) | (rgb[1] << 8) | rgb[2]) + 1;
+        }
+        static size_t slotOf(uint32_t key) {
+            return (key * 2654435761u) >> 25;
+        }
+        void insert(const uint8_t* rgb) {
+            uint32_t key = keyOf(rgb);
+            size_t s = slotOf(key);
+            while (keys[s] && keys[s] != key) s = (s + 1) & (kSlots - 1);
+            if (keys[s]) return;
+            if (count == kMaxPalette) {
+                count++;
+                return;
+            }
+            keys[s] = key;
+            index[s] = static_cast<uint8_t>(count);
+            memcpy(&colours[count * 3], rgb, 3);
+            count++;
+        }
+        uint8_t find(const uint8_t* rgb) const {
+            uint32_t key = keyOf(rgb);
+            size_t s = slotOf(key);
+            while (keys[s] != key) s = (s + 1) & (kSlots - 1);
+            return index[s];
+        }
+    };
+
+    static uint8_t* putVarint(uint8_t* o, size_t v) {
+        while (v >= 0x80) {
+            *o++ = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        *o++ = static_cast<uint8_t>(v);
+        return o;
+    }
+
+    static bool getVarint(const uint8_t*& in, const uint8_t* end, size_t* out) {
+        size_t v = 0;
+        for (int shift = 0; shift < 21; shift += 7) {
+            if (in >= end) return false;
+            uint8_t b = *in++;
+            v |= static_cast<size_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                *out = v;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // MIRRORCODEC_H
@@ -10,7 +10,8 @@ class NetworkManager {
         bool checkWifiConnection();
         void initializeWebsocket();
         bool checkWebsocketConnection();
-        void onWebSocketMessage(websockets::WebsocketsMessage msg);
+        void onWebSocketMessage(websockets::WebsocketsMessage& msg);
+        void sendMirrorFrame();
         void poll();
 
     private:
@@ -0,0 +1,40 @@
+#ifndef POWERMANAGER_H
+#define POWERMANAGER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Upper bound on a single idle block. The websocket library only reads the
+// socket from poll(), so the loop has to come back around at least this often.
+#ifndef POWER_POLL_SLICE_MS
+#define POWER_POLL_SLICE_MS 50
+#endif
+
+// Rough board current draw used to turn the measured duty cycle into an
+// estimated average. Tune for your supply; LED strip current is not included.
+#ifndef POWER_ACTIVE_MA
+#define POWER_ACTIVE_MA 95.0f
+#endif
+#ifndef POWER_IDLE_MA
+#define POWER_IDLE_MA 40.0f
+#endif
+
+class PowerManager {
+public:
+    static void initialize();
+    static void idleFor(unsigned long waitMs);
+    static void wake();
+    static void wakeFromISR();
+    static float dutyCyclePercent();
+    static float estimatedCurrentMa();
+    static void printPowerUsage();
+    static void resetStats();
+private:
+    static TaskHandle_t loopTask;
+    static unsigned long windowStartUs;
+    static unsigned long idleUs;
+    static unsigned long loopCount;
+};
+
+#endif // POWERMANAGER_H
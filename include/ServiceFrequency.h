@@ -0,0 +1,70 @@
+#ifndef SERVICEFREQUENCY_H
+#define SERVICEFREQUENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+// Sliding window the heatmap averages over, split into HEAT_BUCKETS equal
+// buckets. The window advances one bucket at a time.
+#ifndef HEAT_WINDOW_MINUTES
+#define HEAT_WINDOW_MINUTES 60
+#endif
+#ifndef HEAT_BUCKETS
+#define HEAT_BUCKETS 12
+#endif
+
+// Trains per hour shown at full heat (red). 30 is a train every 2 minutes.
+#ifndef HEAT_FULL_SCALE_TPH
+#define HEAT_FULL_SCALE_TPH 30
+#endif
+
+// Per-station arrivals in the last HEAT_WINDOW_MINUTES. Fixed size: one
+// count per bucket plus their running sum. A bucket saturates at 255
+// arrivals and drops the rest; see the static_asserts below for why that
+// cannot change the displayed level.
+struct ServiceCounter {
+    uint8_t buckets[HEAT_BUCKETS];
+    uint16_t total;
+};
+
+// Bucketed sliding-window arrival counts for the heatmap display mode.
+// record() adds to the current bucket when a train enters its window;
+// advance() retires expired buckets once per bucket period across all
+// stations. Rendering reads each station's running total, so it is
+// O(stations) with no history scan.
+class ServiceFrequency {
+public:
+    static constexpr uint32_t kBucketSeconds = HEAT_WINDOW_MINUTES * 60UL / HEAT_BUCKETS;
+
+    static void record(ServiceCounter& counter);
+
+    // Moves the window up to now. Returns true if any bucket was retired.
+    static bool advance(time_t now);
+    static bool isAdvanceDue(time_t now);
+    static unsigned long msUntilNextBucket();
+
+    // 0..255 heat for a station, scaled to HEAT_FULL_SCALE_TPH. Until a full
+    // window has passed since boot the rate is taken over the time covered.
+    static uint8_t level(const ServiceCounter& counter);
+    static uint32_t trainsPerHour(const ServiceCounter& counter);
+
+    // Blue (quiet) through green and yellow to red (busy), 0xRRGGBB.
+    static uint32_t color(uint8_t level);
+
+private:
+    static void retire(uint32_t slot);
+
+    static uint32_t currentBucket;   // time / kBucketSeconds, 0 until time is set
+    static uint32_t firstBucket;
+    static uint32_t levelScale;      // level = total * levelScale >> 16
+};
+
+static_assert(HEAT_WINDOW_MINUTES * 60UL % HEAT_BUCKETS == 0, "HEAT_WINDOW_MINUTES must split evenly into HEAT_BUCKETS");
+// One full bucket alone must reach full heat, so saturation only clips
+// trainsPerHour(), never level().
+static_assert(HEAT_FULL_SCALE_TPH * HEAT_WINDOW_MINUTES <= UINT8_MAX * 60UL,
+              "a saturated heat bucket would be shown below full scale");
+static_assert(HEAT_BUCKETS * UINT8_MAX <= UINT16_MAX, "ServiceCounter::total is 16 bits");
+
+#endif // SERVICEFREQUENCY_H
@@ -1,18 +1,37 @@
 #ifndef STATION_H
 #define STATION_H
 
-#include <string>
+#include <ctime>
+#include <cstdint>
 #include <vector>
+#include "ServiceFrequency.h"
 #include "Train.h"
 
 class Station {
 public:
     Station();
-    Station(const std::string& id, const std::string& name);
+    Station(const char* id, const char* name);
 
-    std::string id;
-    std::string name;
+    // Borrowed: string literals in the compiled-in map or the mapped
+    // station map image. Never freed.
+    const char* id;
+    const char* name;
     std::vector<Train> trains;
+
+    // Route bitsets indexed by SubwayColorMap route code. presentRoutes holds
+    // the routes with a train in the arrival window as of the last
+    // checkArrivals(); routeMask is every route the feed has listed here.
+    uint32_t presentRoutes;
+    uint32_t routeMask;
+
+    // Hash of the last applied feed record and the time until which an
+    // identical record can be skipped (when a rejected future train would
+    // come into range).
+    uint32_t feedDigest;
+    time_t digestExpires;
+
+    // Arrivals over the heatmap window, bumped as trains enter.
+    ServiceCounter frequency;
 };
 
-#endif // STATION_H
\ No newline at end of file
+#endif // STATION_H
@@ -0,0 +1,52 @@
+#ifndef STATIONMAP_H
+#define STATIONMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MemoryPolicy.h"
+#include "Station.h"
+
+// Borrowed tables behind the runtime station map: either the compiled-in
+// GeneratedStationMap arrays or the mapped station map image.
+struct StationLayout {
+    uint16_t ledCount;            // LEDs covered by the map, spacers included
+    uint16_t complexCount;
+    const uint16_t* ledStart;     // stations.size() + 1 entries
+    const uint16_t* leds;         // ledStart[stations.size()] entries
+    const uint16_t* ledComplex;   // ledCount entries
+    const char (*complexIds)[4];
+};
+
+// One Station per feed stop ID, sorted by ID so lookups binary search. A
+// station drawn at several points on the map owns a contiguous span of the
+// CSR LED table, so one update fans out to all of its LEDs without duplicate
+// Station objects or train lists. Each LED also maps back to its parent
+// complex (parent_id in stations.csv).
+class StationMap {
+public:
+    static constexpr uint16_t kNoComplex = 0xFFFF;
+
+    // Read on every frame, so kept in internal RAM.
+    using StationList = std::vector<Station, InternalAllocator<Station>>;
+    static StationList stations;
+
+    static void useGenerated();
+    static void use(const StationLayout& tables);
+
+    static int indexOf(const char* id);
+    static size_t indexOf(const Station& station) { return &station - stations.data(); }
+    static Station* find(const char* id);
+
+    static const uint16_t* ledsBegin(size_t station) { return layout.leds + layout.ledStart[station]; }
+    static const uint16_t* ledsEnd(size_t station) { return layout.leds + layout.ledStart[station + 1]; }
+    static uint16_t ledCount() { return layout.ledCount; }
+    static uint16_t complexCount() { return layout.complexCount; }
+    static uint16_t complexOf(uint16_t led);
+    static const char* complexId(uint16_t complex);
+
+private:
+    static StationLayout layout;
+};
+
+#endif // STATIONMAP_H
@@ -0,0 +1,62 @@
+#ifndef STATION_MAP_IMAGE_H
+#define STATION_MAP_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Binary station map written by scripts/generate_station_map.py and flashed
+// to the "stationmap" data partition. Layout (little endian):
+//
+//   StationMapHeader
+//   StationMapEntry[stationCount]   sorted by id
+//   uint16_t ledStart[stationCount + 1]
+//   uint16_t leds[ledStart[stationCount]]     CSR station -> LED fan-out
+//   uint16_t ledComplex[ledCount]             0xFFFF for spacer LEDs
+//   char complexIds[complexCount][4]
+//   name pool                                 NUL-terminated names
+//
+// The image is read in place through a flash mmap, so Station::id, names
+// and the StationMap tables point straight into it and nothing is copied
+// to heap.
+
+#define STATION_MAP_IMAGE_MAGIC 0x424D534EUL  // "NSMB"
+#define STATION_MAP_IMAGE_VERSION 2
+#define STATION_MAP_PARTITION_LABEL "stationmap"
+
+struct StationMapHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t stationCount;
+    uint16_t ledCount;
+    uint16_t complexCount;
+    uint32_t ledStartOffset;   // section offsets from start of image
+    uint32_t ledsOffset;
+    uint32_t ledComplexOffset;
+    uint32_t complexOffset;
+    uint32_t nameOffset;
+    uint32_t nameSize;
+    uint32_t totalSize;
+    uint32_t crc32;            // CRC-32 (zlib) of bytes [sizeof(header), totalSize)
+};
+
+struct StationMapEntry {
+    char id[4];                // NUL-padded stop_id
+    uint16_t nameOffset;       // into the name pool
+    uint16_t reserved;
+};
+
+static_assert(sizeof(StationMapHeader) == 44, "StationMapHeader layout");
+static_assert(sizeof(StationMapEntry) == 8, "StationMapEntry layout");
+
+class StationMapImage {
+public:
+    static bool load();
+    static bool validate(const uint8_t* data, size_t size);
+    static bool isLoaded();
+private:
+    static uint32_t crc32(const uint8_t* data, size_t length);
+
+    static const StationMapHeader* header;
+};
+
+#endif // STATION_MAP_IMAGE_H
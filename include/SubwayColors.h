@@ -23,8 +23,17 @@ public:
     SubwayColorMap();
     SubwayColor getColor(const std::string& routeId) const;
 
+    // Compact route codes (0..kRouteCount-1) for fixed-width storage.
+    // kUnknownRoute is returned for IDs not in the table.
+    static constexpr uint8_t kRouteCount = 31;
+    static constexpr uint8_t kUnknownRoute = 31;
+    static uint8_t routeCode(const char* routeId);
+    static const char* routeName(uint8_t code);
+    SubwayColor colorForCode(uint8_t code) const;
+
 private:
     std::map<std::string, SubwayColor> routeColors;
+    SubwayColor codeColors[kRouteCount + 1];
 };
 
 #endif // SUBWAY_COLORS_H
\ No newline at end of file
@@ -1,10 +1,72 @@
 #ifndef TIMEMANAGER_H
 #define TIMEMANAGER_H
 
+#include <cstdint>
+#include <ctime>
+
+// Corrections at or above this are applied as a step; smaller ones are
+// slewed with adjtime() so arrival windows don't jump.
+#ifndef FEED_CLOCK_STEP_MS
+#define FEED_CLOCK_STEP_MS 1000
+#endif
+
+// Errors within this band are left alone.
+#ifndef FEED_CLOCK_DEADBAND_MS
+#define FEED_CLOCK_DEADBAND_MS 50
+#endif
+
+// Messages per correction. The estimate is the sample with the least
+// network delay in the window.
+#ifndef FEED_CLOCK_WINDOW
+#define FEED_CLOCK_WINDOW 4
+#endif
+
+// The clock is disciplined to the feed server's send time (sent_ms), which
+// arrives with every message. The first message sets the clock outright, so
+// trains pass the window check without waiting for NTP. NTP still runs: until
+// the feed has set the clock it sets it, and afterwards its result is only
+// compared against the clock and reported.
+//
+// SNTP results arrive on the lwIP task. They are queued there and applied by
+// poll() on the loop task, so the clock and this class's state only ever
+// change on the loop, alongside onServerTime().
 class TimeManager {
 public:
+    enum Source : uint8_t { Unset, Feed, Ntp };
+
     static void initializeTime();
-    static void printCurrentTime();    
+    static void printCurrentTime();
+
+    // Applies a queued SNTP result, if any. Call from loop().
+    static void poll();
+
+    // sent_ms from a feed message and the micros() at which it was received.
+    static void onServerTime(int64_t serverMs, uint32_t receivedUs);
+    // An NTP time and the micros() at which SNTP delivered it.
+    static void onNtpTime(const struct timeval& ntp, uint32_t receivedUs);
+
+    static bool isTimeValid();
+    static Source source();
+    static int64_t feedOffsetMs();    // last estimate of server minus device
+    static int64_t ntpOffsetMs();     // NTP minus device at the last NTP sync
+    static uint32_t clockSteps();
+    static uint32_t clockSlews();
+
+    // Parses MTAPI's ISO 8601 times ("2024-09-27T14:23:30-04:00", "...Z")
+    // to epoch seconds using the offset in the string rather than the TZ
+    // rules, so DST changes can't skew it.
+    static bool parseFeedTime(const char* text, time_t* out);
+
+private:
+    static void step(int64_t deltaMs);
+
+    static Source clockSource;
+    static int64_t windowBestMs;
+    static uint8_t windowSamples;
+    static int64_t lastFeedOffsetMs;
+    static int64_t lastNtpOffsetMs;
+    static uint32_t steps;
+    static uint32_t slews;
 };
 
-#endif // TIMEMANAGER_H
\ No newline at end of file
+#endif // TIMEMANAGER_H
@@ -0,0 +1,68 @@
+#ifndef TIMESCRUB_H
+#define TIMESCRUB_H
+
+#include <Arduino.h>
+#include <cstdint>
+#include <ctime>
+
+// Active-low push button that scrubs forward while held; a tap returns to
+// live. -1 leaves the button out.
+#ifndef SCRUB_BUTTON_PIN
+#define SCRUB_BUTTON_PIN -1
+#endif
+
+// Preview seconds advanced per real second while the button is held.
+#ifndef SCRUB_RATE
+#define SCRUB_RATE 120
+#endif
+
+// Frame interval while scrubbing (about 30 fps).
+#ifndef SCRUB_FRAME_MS
+#define SCRUB_FRAME_MS 33
+#endif
+
+// Shows the map as it will look at now + offset, out to the horizon store's
+// end, without touching live state: checkArrivals() keeps running and only
+// renderArrivals() reads the preview time. Offset 0 is live.
+//
+// Controls:
+//   Serial     "+90", "-90", "600", "15m", "live" (seconds unless suffixed m)
+//   WebSocket  {"scrub":600} from the feed server
+//   Button     SCRUB_BUTTON_PIN, hold to scrub, tap for live
+class TimeScrub {
+public:
+    static void begin();
+
+    // Reads serial commands and the button. Call every loop.
+    static void poll();
+
+    // Applies a {"scrub":<seconds>} control message. Returns false if the
+    // payload isn't one, so it can go on to the parser.
+    static bool handleMessage(const char* payload, size_t length);
+
+    // Clamped to [0, HORIZON_SECONDS].
+    static void setOffset(int32_t seconds);
+    static int32_t offset();
+
+    // now + offset, or 0 when live.
+    static time_t previewTime();
+
+    static bool needsRender();
+    static void markRendered(time_t at);
+    static unsigned long msUntilNextStep();
+
+private:
+    static bool applyCommand(const char* text);
+    static void IRAM_ATTR onButton();
+
+    static int32_t offsetSeconds;
+    static time_t renderedAt;
+    static bool dirty;
+    static char line[16];
+    static uint8_t lineLength;
+    static bool held;
+    static unsigned long holdStartMs;
+    static unsigned long lastStepMs;
+};
+
+#endif // TIMESCRUB_H
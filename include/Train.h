@@ -1,19 +1,32 @@
 #ifndef TRAIN_H
 #define TRAIN_H
 
-#include <string>
 #include <ctime>
+#include <cstdint>
 
 class Train {
 public:
+    // Direction list of the feed record the train came from. Trains promoted
+    // from the horizon store don't know theirs.
+    enum Direction : uint8_t { North, South, Promoted };
+
     Train();
-    Train(const std::string& routeId, time_t arrivalTime);
+    Train(uint8_t route, time_t arrivalTime, uint8_t feed = 0, Direction direction = Promoted);
+
+    // Order of a station's train list: arrival time, then route.
+    static bool earlier(const Train& a, const Train& b) {
+        return a.arrivalTime != b.arrivalTime ? a.arrivalTime < b.arrivalTime : a.route < b.route;
+    }
 
     bool atStation(time_t currentTime) const;
+    time_t departureTime() const;
 
-    std::string routeId;
+    uint8_t route;     // SubwayColorMap route code
     time_t arrivalTime;
-private:
+    bool arrived;  // set once checkArrivals has seen the train enter its window
+    uint8_t feed;      // feed ID of the generation that listed it
+    uint8_t direction; // Direction
+
     static const uint8_t arrivalWindowSeconds = 30;
 };
 
@@ -1,26 +1,74 @@
 import csv
 import datetime
+import struct
+import zlib
 from pathlib import Path
 
 csv_file_path = 'stations.csv'
 header_file_path = '../include/GeneratedStationMap.h'
 cpp_file_path = '../src/GeneratedStationMap.cpp'
+image_file_path = '../data/stationmap.bin'
 
-stations = []
-led_index = 0
+# Must match include/StationMapImage.h
+IMAGE_MAGIC = 0x424D534E  # "NSMB"
+IMAGE_VERSION = 2
+IMAGE_HEADER = struct.Struct('<IHHHHIIIIIIII')
+IMAGE_ENTRY = struct.Struct('<4sHH')
+NO_COMPLEX = 0xFFFF
+
+# One CSV row per LED, in strip order. A stop_id may appear on several rows
+# (a station drawn at more than one point on the map); rows with an empty
+# stop_id are spacer LEDs that belong to no station.
+leds = []
 with open(csv_file_path, mode='r') as csv_file:
     csv_reader = csv.DictReader(csv_file)
     for row in csv_reader:
-        stations.append({
-            'stop_id': row['stop_id'],
+        stop_id = row['stop_id'].strip()
+        leds.append({
+            'stop_id': stop_id,
             'name': row['name'],
-            'ledIndex': led_index
+            'parent_id': (row.get('parent_id') or stop_id).strip(),
         })
-        led_index += 1
+
+# One station per feed stop ID, sorted the way the firmware binary searches.
+by_id = {}
+for led_index, led in enumerate(leds):
+    if not led['stop_id']:
+        continue
+    station = by_id.setdefault(led['stop_id'], {'stop_id': led['stop_id'], 'name': led['name'], 'leds': []})
+    station['leds'].append(led_index)
+stations = sorted(by_id.values(), key=lambda s: s['stop_id'].encode('utf-8'))
+
+# CSR fan-out: the LEDs of station i are led_list[led_start[i]:led_start[i + 1]].
+led_start = [0]
+led_list = []
+for station in stations:
+    led_list += station['leds']
+    led_start.append(len(led_list))
+
+complex_ids = sorted({led['parent_id'] for led in leds if led['stop_id']}, key=lambda c: c.encode('utf-8'))
+complex_index = {c: i for i, c in enumerate(complex_ids)}
+led_complex = [complex_index[led['parent_id']] if led['stop_id'] else NO_COMPLEX for led in leds]
+
+for stop_id in [s['stop_id'] for s in stations] + complex_ids:
+    if len(stop_id.encode('utf-8')) > 3:
+        raise ValueError(f"ID {stop_id!r} does not fit the 4-byte ID field")
 
 current_time = datetime.datetime.now().strftime("%Y-%m-%d %H:%M:%S")
 
-# Header: extern declaration only (single storage defined in .cpp)
+
+def c_string(value):
+    return '"' + value.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def c_array(values, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(str(v) for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+# Header: extern declarations only (single storage defined in .cpp)
 header_content = f"""#ifndef STATION_MAP_H
 #define STATION_MAP_H
 
@@ -28,16 +76,25 @@ header_content = f"""#ifndef STATION_MAP_H
  * Auto-generated station map header file
  * Generated on: {current_time}
  *
- * IMPORTANT: Only declares the stationMap symbol.
- * The definition is generated in src/GeneratedStationMap.cpp to avoid
- * duplicate copies across translation units.
+ * Compiled-in station layout, used when no station map image is flashed.
+ * One station per feed stop ID, sorted by ID. The LEDs of station i are
+ * generatedStationLeds[generatedStationLedStart[i] .. generatedStationLedStart[i + 1]);
+ * generatedLedComplex gives each LED's parent complex (0xFFFF for spacers).
  */
 
-#include <string>
-#include <map>
-#include "Station.h"
+#include <cstdint>
+
+#define GENERATED_STATION_COUNT {len(stations)}
+#define GENERATED_FANOUT_COUNT {len(led_list)}
+#define GENERATED_LED_COUNT {len(leds)}
+#define GENERATED_COMPLEX_COUNT {len(complex_ids)}
 
-extern std::map<int, Station> stationMap;
+extern const char* const generatedStationIds[GENERATED_STATION_COUNT];
+extern const char* const generatedStationNames[GENERATED_STATION_COUNT];
+extern const uint16_t generatedStationLedStart[GENERATED_STATION_COUNT + 1];
+extern const uint16_t generatedStationLeds[GENERATED_FANOUT_COUNT];
+extern const uint16_t generatedLedComplex[GENERATED_LED_COUNT];
+extern const char generatedComplexIds[GENERATED_COMPLEX_COUNT][4];
 
 #endif // STATION_MAP_H
 """
@@ -46,18 +103,79 @@ extern std::map<int, Station> stationMap;
 cpp_content = f"""// Auto-generated on: {current_time}
 #include "GeneratedStationMap.h"
 
-std::map<int, Station> stationMap = {{
+const char* const generatedStationIds[GENERATED_STATION_COUNT] = {{
+{c_array([c_string(s['stop_id']) for s in stations], 10)}
+}};
+
+const char* const generatedStationNames[GENERATED_STATION_COUNT] = {{
+{c_array([c_string(s['name']) for s in stations], 1)}
+}};
+
+const uint16_t generatedStationLedStart[GENERATED_STATION_COUNT + 1] = {{
+{c_array(led_start, 16)}
+}};
+
+const uint16_t generatedStationLeds[GENERATED_FANOUT_COUNT] = {{
+{c_array(led_list, 16)}
+}};
+
+const uint16_t generatedLedComplex[GENERATED_LED_COUNT] = {{
+{c_array(led_complex, 16)}
+}};
+
+const char generatedComplexIds[GENERATED_COMPLEX_COUNT][4] = {{
+{c_array([c_string(c) for c in complex_ids], 10)}
+}};
 """
 
-for station in stations:
-    stop_id = station["stop_id"].replace('"', '\\"')
-    name = station["name"].replace('"', '\\"')
-    cpp_content += f'    {{{station["ledIndex"]}, Station("{stop_id}", "{name}")}},\n'
 
-cpp_content += "};\n"
+def build_image():
+    """Binary station map for the "stationmap" flash partition.
+
+    Same tables as the generated source: station entries sorted by stop_id
+    (binary searched in place), the CSR LED fan-out, the LED-to-complex
+    table, complex IDs and a shared NUL-terminated name pool.
+    """
+    name_pool = bytearray()
+    name_offsets = {}
+    for station in stations:
+        name = station['name']
+        if name not in name_offsets:
+            name_offsets[name] = len(name_pool)
+            name_pool += name.encode('utf-8') + b'\0'
+
+    entries = bytearray()
+    for station in stations:
+        entries += IMAGE_ENTRY.pack(station['stop_id'].encode('utf-8'), name_offsets[station['name']], 0)
+
+    def u16(values):
+        return struct.pack(f'<{len(values)}H', *values)
+
+    sections = [
+        bytes(entries),
+        u16(led_start),
+        u16(led_list),
+        u16(led_complex),
+        b''.join(c.encode('utf-8').ljust(4, b'\0') for c in complex_ids),
+        bytes(name_pool),
+    ]
+    offsets = []
+    offset = IMAGE_HEADER.size
+    for section in sections:
+        offsets.append(offset)
+        offset += len(section)
+    body = b''.join(sections)
+    total_size = IMAGE_HEADER.size + len(body)
+    header = IMAGE_HEADER.pack(IMAGE_MAGIC, IMAGE_VERSION, len(stations), len(leds), len(complex_ids),
+                               offsets[1], offsets[2], offsets[3], offsets[4], offsets[5],
+                               len(name_pool), total_size, zlib.crc32(body) & 0xFFFFFFFF)
+    return header + body
+
 
 # Write files
 Path(header_file_path).write_text(header_content, encoding="utf-8")
 Path(cpp_file_path).write_text(cpp_content, encoding="utf-8")
+Path(image_file_path).parent.mkdir(parents=True, exist_ok=True)
+Path(image_file_path).write_bytes(build_image())
 
-print(f"Generated {header_file_path} and {cpp_file_path} successfully.")
\ No newline at end of file
+print(f"Generated {header_file_path}, {cpp_file_path} and {image_file_path} successfully.")
@@ -0,0 +1,139 @@
+#include "AllocTracker.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <cassert>
+#include <cstdio>
+#endif
+
+namespace {
+const char* const kSubsystemNames[AllocTracker::SubsystemCount] = {
+  "other", "network", "parse", "arrivals", "render", "diagnostics"
+};
+
+#ifdef ARDUINO
+TaskHandle_t loopTask = nullptr;
+#endif
+}
+
+uint32_t AllocTracker::counts[SubsystemCount] = {};
+uint64_t AllocTracker::byteCounts[SubsystemCount] = {};
+uint32_t AllocTracker::frees = 0;
+uint32_t AllocTracker::reportedViolations = 0;
+bool AllocTracker::baselined = false;
+
+// Only the loop task sets subsystem markers, so allocations from other
+// tasks are counted as Other.
+void AllocTracker::begin() {
+#ifdef ARDUINO
+  loopTask = xTaskGetCurrentTaskHandle();
+#endif
+}
+
+void AllocTracker::noteAlloc(size_t size) {
+  Subsystem subsystem = current;
+#ifdef ARDUINO
+  if (xTaskGetCurrentTaskHandle() != loopTask) subsystem = Other;
+#endif
+  counts[subsystem]++;
+  byteCounts[subsystem] += size;
+}
+
+void AllocTracker::noteFree() {
+  frees++;
+}
+
+uint32_t AllocTracker::allocations(Subsystem subsystem) {
+  return subsystem < SubsystemCount ? counts[subsystem] : 0;
+}
+
+uint64_t AllocTracker::bytes(Subsystem subsystem) {
+  return subsystem < SubsystemCount ? byteCounts[subsystem] : 0;
+}
+
+uint32_t AllocTracker::liveAllocations() {
+  uint32_t total = 0;
+  for (uint32_t count : counts) total += count;
+  return total - frees;
+}
+
+const char* AllocTracker::name(Subsystem subsystem) {
+  return subsystem < SubsystemCount ? kSubsystemNames[subsystem] : "?";
+}
+
+// The first call only takes a baseline: drivers may allocate on the first
+// frame they push.
+void AllocTracker::checkSteadyState() {
+  uint32_t violations = counts[Arrivals] + counts[Render];
+  if (!baselined) {
+    reportedViolations = violations;
+    baselined = true;
+    return;
+  }
+  if (violations == reportedViolations) return;
+#ifdef ARDUINO
+  Serial.printf("[Heap] %lu allocations in the arrivals/render path\n",
+                static_cast<unsigned long>(violations - reportedViolations));
+#else
+  fprintf(stderr, "%u allocations in the arrivals/render path\n",
+          static_cast<unsigned>(violations - reportedViolations));
+  assert(violations == reportedViolations);
+#endif
+  reportedViolations = violations;
+}
+
+#if ALLOC_TRACKING
+namespace {
+void* countedAlloc(size_t size) {
+  AllocTracker::noteAlloc(size);
+  return malloc(size ? size : 1);
+}
+
+void countedFree(void* ptr) {
+  if (!ptr) return;
+  AllocTracker::noteFree();
+  free(ptr);
+}
+}
+
+void* operator new(size_t size) {
+  void* ptr = countedAlloc(size);
+  if (!ptr) abort();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  void* ptr = countedAlloc(size);
+  if (!ptr) abort();
+  return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  countedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  countedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  countedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  countedFree(ptr);
+}
+#endif
@@ -0,0 +1,280 @@
+#include "ArrivalHistory.h"
+#include <Arduino.h>
+#include <WebServer.h>
+#include <algorithm>
+#include <cstring>
+#include "MemoryPolicy.h"
+#include "Metrics.h"
+#include "StationMap.h"
+#include "SubwayColors.h"
+
+namespace {
+constexpr uint8_t kStationBits = 9;
+constexpr uint8_t kRouteBits = 5;
+constexpr uint16_t kMaxEventBits = 2 + 32 + kStationBits + kRouteBits;
+// Arrivals are recorded as they enter their window, so an event can be up to
+// one window older than the newest event already logged.
+constexpr uint32_t kLateSlackSeconds = 60;
+constexpr size_t kMaxHistoryLines = 500;
+
+void putBits(uint8_t* data, uint16_t& pos, uint32_t value, uint8_t bits) {
+  uint8_t done = 0;
+  while (done < bits) {
+    uint8_t shift = pos & 7;
+    uint8_t take = std::min<uint8_t>(8 - shift, bits - done);
+    data[pos >> 3] |= static_cast<uint8_t>(((value >> done) & ((1U << take) - 1)) << shift);
+    done += take;
+    pos += take;
+  }
+}
+
+uint32_t getBits(const uint8_t* data, uint16_t& pos, uint8_t bits) {
+  uint32_t value = 0;
+  uint8_t done = 0;
+  while (done < bits) {
+    uint8_t shift = pos & 7;
+    uint8_t take = std::min<uint8_t>(8 - shift, bits - done);
+    value |= static_cast<uint32_t>((data[pos >> 3] >> shift) & ((1U << take) - 1)) << done;
+    done += take;
+    pos += take;
+  }
+  return value;
+}
+
+void putDelta(uint8_t* data, uint16_t& pos, int32_t delta) {
+  uint32_t z = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+  if (z < 16) {
+    putBits(data, pos, 0, 1);
+    putBits(data, pos, z, 4);
+  } else if (z < 1024) {
+    putBits(data, pos, 1, 2);
+    putBits(data, pos, z, 10);
+  } else {
+    putBits(data, pos, 3, 2);
+    putBits(data, pos, z, 32);
+  }
+}
+
+int32_t getDelta(const uint8_t* data, uint16_t& pos) {
+  uint32_t z;
+  if (getBits(data, pos, 1) == 0) {
+    z = getBits(data, pos, 4);
+  } else if (getBits(data, pos, 1) == 0) {
+    z = getBits(data, pos, 10);
+  } else {
+    z = getBits(data, pos, 32);
+  }
+  return static_cast<int32_t>(z >> 1) ^ -static_cast<int32_t>(z & 1);
+}
+
+struct TimeCollector {
+  uint32_t* out;
+  size_t count;
+  size_t max;
+};
+
+void collectTime(const HistoryEvent& event, void* context) {
+  auto* collector = static_cast<TimeCollector*>(context);
+  if (collector->count < collector->max) collector->out[collector->count++] = event.time;
+}
+
+WebServer* http = nullptr;
+
+void sendEvent(const HistoryEvent& event, void* context) {
+  size_t* lines = static_cast<size_t*>(context);
+  if (++*lines > kMaxHistoryLines) return;
+  char line[64];
+  snprintf(line, sizeof(line), "%lu %s %s\n",
+           static_cast<unsigned long>(event.time),
+           SubwayColorMap::routeName(event.route),
+           event.station < StationMap::stations.size() ? StationMap::stations[event.station].id : "?");
+  http->sendContent(line);
+}
+
+// GET /history?stop=A33&route=A&from=<epoch>&to=<epoch>
+// Every parameter is optional; the range defaults to the last hour.
+void handleHistory() {
+  uint32_t to = http->hasArg("to") ? strtoul(http->arg("to").c_str(), nullptr, 10) : time(nullptr);
+  uint32_t from = http->hasArg("from") ? strtoul(http->arg("from").c_str(), nullptr, 10) : to - 3600;
+  int station = -1;
+  int route = -1;
+  if (http->hasArg("stop")) {
+    station = StationMap::indexOf(http->arg("stop").c_str());
+    if (station < 0) {
+      http->send(404, "text/plain", "unknown stop\n");
+      return;
+    }
+  }
+  if (http->hasArg("route")) {
+    route = SubwayColorMap::routeCode(http->arg("route").c_str());
+  }
+
+  http->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  http->send(200, "text/plain", "");
+  size_t lines = 0;
+  ArrivalHistory::query(from, to, station, route, sendEvent, &lines);
+  http->sendContent("");
+}
+}
+
+uint8_t* ArrivalHistory::storage = nullptr;
+size_t ArrivalHistory::blockCount = 0;
+size_t ArrivalHistory::head = 0;
+size_t ArrivalHistory::used = 0;
+uint32_t ArrivalHistory::lastTime = 0;
+uint32_t ArrivalHistory::runningMax = 0;
+uint32_t ArrivalHistory::totalEvents = 0;
+
+bool ArrivalHistory::begin() {
+  size_t bytes = HISTORY_INTERNAL_BYTES;
+  if (MemoryPolicy::hasExternal()) {
+    bytes = HISTORY_PSRAM_BYTES;
+    storage = static_cast<uint8_t*>(MemoryPolicy::allocate(bytes, MemoryPolicy::External));
+  }
+  if (!storage) {
+    // Without PSRAM, a small log in whatever tier has room.
+    bytes = HISTORY_INTERNAL_BYTES;
+    storage = static_cast<uint8_t*>(MemoryPolicy::allocate(bytes, MemoryPolicy::External));
+  }
+  if (!storage) {
+    Serial.println("Arrival history disabled: allocation failed");
+    return false;
+  }
+  blockCount = bytes / HISTORY_BLOCK_BYTES;
+
+  http = &Metrics::server();
+  http->on("/history", HTTP_GET, handleHistory);
+  Serial.printf("Arrival history: %u blocks, %u KB\n",
+                static_cast<unsigned>(blockCount),
+                static_cast<unsigned>(bytes / 1024));
+  return true;
+}
+
+ArrivalHistory::BlockHeader* ArrivalHistory::blockAt(size_t logical) {
+  size_t oldest = (head + blockCount - used + 1) % blockCount;
+  size_t physical = (oldest + logical) % blockCount;
+  return reinterpret_cast<BlockHeader*>(storage + physical * HISTORY_BLOCK_BYTES);
+}
+
+uint8_t* ArrivalHistory::dataOf(BlockHeader* block) {
+  return reinterpret_cast<uint8_t*>(block) + sizeof(BlockHeader);
+}
+
+void ArrivalHistory::startBlock(uint32_t time) {
+  if (used > 0) head = (head + 1) % blockCount;
+  if (used < blockCount) used++;
+
+  BlockHeader* block = reinterpret_cast<BlockHeader*>(storage + head * HISTORY_BLOCK_BYTES);
+  memset(block, 0, HISTORY_BLOCK_BYTES);
+  block->firstTime = time;
+  block->minTime = time;
+  block->maxTime = std::max(runningMax, time);
+  lastTime = time;
+}
+
+void ArrivalHistory::record(uint32_t time, uint16_t station, uint8_t route) {
+  if (!storage || station >= (1U << kStationBits)) return;
+
+  constexpr uint16_t dataBits = (HISTORY_BLOCK_BYTES - sizeof(BlockHeader)) * 8;
+  BlockHeader* block = reinterpret_cast<BlockHeader*>(storage + head * HISTORY_BLOCK_BYTES);
+  if (used == 0 || block->bitsUsed + kMaxEventBits > dataBits) {
+    startBlock(time);
+    block = reinterpret_cast<BlockHeader*>(storage + head * HISTORY_BLOCK_BYTES);
+  }
+
+  uint8_t* data = dataOf(block);
+  uint16_t pos = block->bitsUsed;
+  putDelta(data, pos, static_cast<int32_t>(time - lastTime));
+  putBits(data, pos, station, kStationBits);
+  putBits(data, pos, route, kRouteBits);
+  block->bitsUsed = pos;
+  block->count++;
+
+  runningMax = std::max(runningMax, time);
+  block->minTime = std::min(block->minTime, time);
+  block->maxTime = runningMax;
+  block->routeMask |= 1UL << route;
+  block->stationBloom |= 1ULL << (station & 63);
+  lastTime = time;
+  totalEvents++;
+}
+
+size_t ArrivalHistory::firstBlockFrom(uint32_t from) {
+  size_t lo = 0;
+  size_t hi = used;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (blockAt(mid)->maxTime < from) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Calls back for every event in [from, to], optionally filtered by station
+// (StationMap index) and route code; pass -1 to match any. Returns the match count.
+size_t ArrivalHistory::query(uint32_t from, uint32_t to, int station, int route,
+                             EventCallback callback, void* context) {
+  if (!storage) return 0;
+  size_t matches = 0;
+  for (size_t i = firstBlockFrom(from); i < used; ++i) {
+    BlockHeader* block = blockAt(i);
+    if (block->minTime > to + kLateSlackSeconds) break;
+    if (block->minTime > to) continue;
+    if (route >= 0 && !(block->routeMask & (1UL << route))) continue;
+    if (station >= 0 && !(block->stationBloom & (1ULL << (station & 63)))) continue;
+
+    const uint8_t* data = dataOf(block);
+    uint16_t pos = 0;
+    uint32_t t = block->firstTime;
+    for (uint16_t n = 0; n < block->count; ++n) {
+      HistoryEvent event;
+      t += getDelta(data, pos);
+      event.time = t;
+      event.station = getBits(data, pos, kStationBits);
+      event.route = getBits(data, pos, kRouteBits);
+      if (event.time < from || event.time > to) continue;
+      if (station >= 0 && event.station != station) continue;
+      if (route >= 0 && event.route != route) continue;
+      matches++;
+      if (callback) callback(event, context);
+    }
+  }
+  return matches;
+}
+
+// Writes the gaps between successive arrivals of a route at a station into
+// out and returns how many were written. At most maxOut arrivals from the
+// start of the range are considered.
+size_t ArrivalHistory::headways(uint16_t station, uint8_t route, uint32_t from, uint32_t to,
+                                uint32_t* out, size_t maxOut) {
+  TimeCollector times = {out, 0, maxOut};
+  query(from, to, station, route, collectTime, &times);
+  std::sort(out, out + times.count);
+
+  // In place: each write lands at or before the older of the two reads.
+  size_t written = 0;
+  for (size_t i = 1; i < times.count; ++i) {
+    if (out[i] == out[i - 1]) continue;
+    out[written++] = out[i] - out[i - 1];
+  }
+  return written;
+}
+
+uint32_t ArrivalHistory::eventCount() {
+  return totalEvents;
+}
+
+size_t ArrivalHistory::bytesUsed() {
+  return used * HISTORY_BLOCK_BYTES;
+}
+
+size_t ArrivalHistory::capacityBytes() {
+  return blockCount * HISTORY_BLOCK_BYTES;
+}
+
+uint32_t ArrivalHistory::oldestTime() {
+  return used > 0 ? blockAt(0)->minTime : 0;
+}
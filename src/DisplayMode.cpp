@@ -0,0 +1,199 @@
+#include "DisplayMode.h"
+#include <Arduino.h>
+#include <WebServer.h>
+#include <climits>
+#include <cstring>
+#include <strings.h>
+#include "Metrics.h"
+#include "PowerManager.h"
+#include "ServiceFrequency.h"
+#include "SubwayColors.h"
+#include "TimeScrub.h"
+
+namespace {
+struct LineGroup {
+  const char* name;
+  const char* routes;
+};
+
+// Trunk lines by their usual names, as route ID lists.
+const LineGroup kLines[] = {
+  {"seventh",   "1,2,3"},
+  {"lexington", "4,5,5X,6,6X"},
+  {"flushing",  "7,7X"},
+  {"eighth",    "A,C,E"},
+  {"sixth",     "B,D,F,FX,M"},
+  {"crosstown", "G"},
+  {"nassau",    "J,Z"},
+  {"canarsie",  "L"},
+  {"broadway",  "N,Q,R,W"},
+  {"shuttles",  "S,GS,FS,H"},
+  {"sir",       "SI"},
+};
+
+WebServer* http = nullptr;
+
+uint32_t routeListMask(const char* list) {
+  uint32_t mask = 0;
+  char token[4];
+  size_t len = 0;
+  for (const char* p = list;; ++p) {
+    if (*p == ',' || *p == '\0') {
+      token[len] = '\0';
+      uint8_t code = SubwayColorMap::routeCode(token);
+      if (code == SubwayColorMap::kUnknownRoute) return 0;
+      mask |= 1UL << code;
+      len = 0;
+      if (*p == '\0') break;
+    } else if (len < sizeof(token) - 1) {
+      token[len++] = static_cast<char>(toupper(static_cast<unsigned char>(*p)));
+    } else {
+      return 0;
+    }
+  }
+  return mask;
+}
+
+void handleMode() {
+  if (http->hasArg("routes")) {
+    uint32_t mask = DisplayMode::parseRoutes(http->arg("routes").c_str());
+    if (mask == 0) {
+      http->send(400, "text/plain", "unknown route or line\n");
+      return;
+    }
+    DisplayMode::setFilter(mask);
+  }
+  if (http->hasArg("cycle")) {
+    DisplayMode::setCycling(strcmp(http->arg("cycle").c_str(), "0") != 0);
+  }
+  if (http->hasArg("view")) {
+    String view = http->arg("view");
+    if (strcasecmp(view.c_str(), "heat") == 0) {
+      DisplayMode::setView(DisplayMode::Heatmap);
+    } else if (strcasecmp(view.c_str(), "arrivals") == 0) {
+      DisplayMode::setView(DisplayMode::Arrivals);
+    } else {
+      http->send(400, "text/plain", "unknown view\n");
+      return;
+    }
+  }
+
+  String body = "routes=";
+  uint32_t mask = DisplayMode::filterMask();
+  if (mask == DisplayMode::kAllRoutes) {
+    body += "all";
+  } else {
+    bool first = true;
+    for (uint8_t code = 0; code < SubwayColorMap::kRouteCount; ++code) {
+      if (!(mask & (1UL << code))) continue;
+      if (!first) body += ",";
+      body += SubwayColorMap::routeName(code);
+      first = false;
+    }
+  }
+  body += DisplayMode::isCycling() ? " cycle=1" : " cycle=0";
+  body += DisplayMode::view() == DisplayMode::Heatmap ? " view=heat\n" : " view=arrivals\n";
+  http->send(200, "text/plain", body);
+}
+}
+
+uint32_t DisplayMode::filter = DisplayMode::kAllRoutes;
+bool DisplayMode::cycling = false;
+DisplayMode::View DisplayMode::current = DisplayMode::Arrivals;
+bool DisplayMode::dirty = true;
+uint32_t DisplayMode::renderedStep = 0;
+
+void DisplayMode::begin() {
+  http = &Metrics::server();
+  http->on("/mode", HTTP_GET, handleMode);
+}
+
+void DisplayMode::setFilter(uint32_t routeMask) {
+  if (routeMask == filter) return;
+  filter = routeMask;
+  dirty = true;
+  PowerManager::wake();
+}
+
+void DisplayMode::setCycling(bool cycle) {
+  if (cycle == cycling) return;
+  cycling = cycle;
+  dirty = true;
+  PowerManager::wake();
+}
+
+void DisplayMode::setView(View v) {
+  if (v == current) return;
+  current = v;
+  dirty = true;
+  PowerManager::wake();
+}
+
+DisplayMode::View DisplayMode::view() {
+  return current;
+}
+
+uint32_t DisplayMode::filterMask() {
+  return filter;
+}
+
+bool DisplayMode::isCycling() {
+  return cycling;
+}
+
+uint32_t DisplayMode::parseRoutes(const char* spec) {
+  if (!spec || !*spec) return 0;
+  if (strcasecmp(spec, "all") == 0) return kAllRoutes;
+
+  uint32_t mask = 0;
+  char token[16];
+  size_t len = 0;
+  for (const char* p = spec;; ++p) {
+    if (*p == ',' || *p == '+' || *p == '\0') {
+      token[len] = '\0';
+      uint32_t bits = 0;
+      for (const LineGroup& line : kLines) {
+        if (strcasecmp(token, line.name) == 0) bits = routeListMask(line.routes);
+      }
+      if (!bits) bits = routeListMask(token);
+      if (!bits) return 0;
+      mask |= bits;
+      len = 0;
+      if (*p == '\0') break;
+    } else if (len < sizeof(token) - 1) {
+      token[len++] = *p;
+    } else {
+      return 0;
+    }
+  }
+  return mask;
+}
+
+uint8_t DisplayMode::pickRoute(uint32_t visibleRoutes, uint32_t step) {
+  if (cycling) {
+    uint32_t skip = step % __builtin_popcount(visibleRoutes);
+    while (skip--) visibleRoutes &= visibleRoutes - 1;
+  }
+  return static_cast<uint8_t>(__builtin_ctz(visibleRoutes));
+}
+
+uint32_t DisplayMode::cycleStep() {
+  return cycling ? millis() / DISPLAY_CYCLE_MS : 0;
+}
+
+// The heatmap also changes when the window drops a bucket, and a preview
+// when it is scrubbed or the clock moves on.
+bool DisplayMode::needsRender() {
+  if (dirty || cycleStep() != renderedStep || TimeScrub::needsRender()) return true;
+  return current == Heatmap && ServiceFrequency::isAdvanceDue(time(nullptr));
+}
+
+void DisplayMode::markRendered(uint32_t step) {
+  renderedStep = step;
+  dirty = false;
+}
+
+unsigned long DisplayMode::msUntilNextCycleStep() {
+  if (!cycling) return ULONG_MAX;
+  return DISPLAY_CYCLE_MS - millis() % DISPLAY_CYCLE_MS;
+}
@@ -0,0 +1,92 @@
+#include "FlightRecorder.h"
+#include <WebServer.h>
+#include <esp_system.h>
+#include <cstring>
+#include "Metrics.h"
+
+namespace {
+constexpr uint32_t kMagic = 0x52464C46;  // "FLFR"
+
+const char* const kEventNames[FlightRecorder::EventCount] = {
+  "boot", "restart", "slow_loop", "parse", "parse_error",
+  "message", "heap", "wifi", "websocket", "loop"
+};
+}
+
+RTC_NOINIT_ATTR FlightRecorder::Ring FlightRecorder::ring;
+uint8_t FlightRecorder::lastResetReason = 0;
+uint32_t FlightRecorder::loopWindowStartMs = 0;
+uint32_t FlightRecorder::loopCount = 0;
+uint64_t FlightRecorder::loopSumUs = 0;
+uint32_t FlightRecorder::loopMaxUs = 0;
+
+// Call first in setup() so the previous session is dumped before anything
+// new is logged over it.
+void FlightRecorder::begin() {
+  esp_reset_reason_t reason = esp_reset_reason();
+  lastResetReason = static_cast<uint8_t>(reason);
+
+  // RTC memory holds garbage after power loss.
+  if (ring.magic != kMagic || reason == ESP_RST_POWERON || reason == ESP_RST_BROWNOUT) {
+    memset(&ring, 0, sizeof(ring));
+    ring.magic = kMagic;
+  } else if (ring.head > 0) {
+    Serial.printf("Flight recorder: %u events from before reset (reason %u)\n",
+                  static_cast<unsigned>(std::min<uint32_t>(ring.head, FLIGHT_RECORDER_EVENTS)),
+                  static_cast<unsigned>(reason));
+    dump(Serial);
+  }
+
+  ring.boots++;
+  log(Boot, lastResetReason, 0);
+  Metrics::server().on("/flightrecorder", HTTP_GET, handleDump);
+}
+
+void FlightRecorder::dump(Print& out) {
+  forEachLine([&out](const char* line) { out.print(line); });
+}
+
+void FlightRecorder::recordLoop(uint32_t activeUs) {
+  if (activeUs > FLIGHT_SLOW_LOOP_US) log(SlowLoop, 0, activeUs);
+  loopCount++;
+  loopSumUs += activeUs;
+  if (activeUs > loopMaxUs) loopMaxUs = activeUs;
+
+  uint32_t nowMs = millis();
+  if (nowMs - loopWindowStartMs < FLIGHT_LOOP_SAMPLE_MS) return;
+  uint64_t meanUs = loopSumUs / loopCount;
+  log(LoopTime, static_cast<uint16_t>(std::min<uint64_t>(meanUs, UINT16_MAX)), loopMaxUs);
+  loopWindowStartMs = nowMs;
+  loopCount = 0;
+  loopSumUs = 0;
+  loopMaxUs = 0;
+}
+
+uint32_t FlightRecorder::bootCount() {
+  return ring.boots;
+}
+
+uint8_t FlightRecorder::resetReason() {
+  return lastResetReason;
+}
+
+// One line per record: <boot> <ms> <event> <arg> <value>
+size_t FlightRecorder::format(const Record& record, char* buf, size_t size) {
+  const char* name = record.type < EventCount ? kEventNames[record.type] : "?";
+  int n = snprintf(buf, size, "%u %lu %s %u %lu\n",
+                   static_cast<unsigned>(record.boot),
+                   static_cast<unsigned long>(record.timeMs),
+                   name,
+                   static_cast<unsigned>(record.arg),
+                   static_cast<unsigned long>(record.value));
+  return n < 0 ? 0 : std::min(static_cast<size_t>(n), size - 1);
+}
+
+// GET /flightrecorder
+void FlightRecorder::handleDump() {
+  WebServer& http = Metrics::server();
+  http.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  http.send(200, "text/plain", "");
+  forEachLine([&http](const char* line) { http.sendContent(line); });
+  http.sendContent("");
+}
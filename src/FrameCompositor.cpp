@@ -0,0 +1,71 @@
+#include "FrameCompositor.h"
+#include "LedKernels.h"
+#include "StationMap.h"
+
+CRGB FrameCompositor::base[NUM_LEDS_SUBWAY];
+CRGB FrameCompositor::arrivals[NUM_LEDS_SUBWAY];
+CRGB FrameCompositor::status[NUM_LEDS_SUBWAY];
+CRGB FrameCompositor::overlay[NUM_LEDS_SUBWAY];
+
+bool FrameCompositor::enabled[LayerCount] = {BASE_MAP_LEVEL > 0, true, false, false};
+uint8_t FrameCompositor::baseLevel = BASE_MAP_LEVEL;
+uint8_t FrameCompositor::statusAlpha = 255;
+uint8_t FrameCompositor::overlayAlpha = 0;
+
+void FrameCompositor::initialize() {
+  LedKernels::fill(reinterpret_cast<uint8_t*>(base), NUM_LEDS_SUBWAY, 0, 0, 0);
+  for (size_t i = 0; i < StationMap::stations.size(); ++i) {
+    for (const uint16_t* led = StationMap::ledsBegin(i); led != StationMap::ledsEnd(i); ++led) {
+      base[*led] = CRGB(255, 255, 255);
+    }
+  }
+}
+
+void FrameCompositor::setEnabled(Layer layer, bool on) {
+  if (layer < LayerCount) enabled[layer] = on;
+}
+
+bool FrameCompositor::isEnabled(Layer layer) {
+  return layer < LayerCount && enabled[layer];
+}
+
+void FrameCompositor::setBaseLevel(uint8_t level) {
+  baseLevel = level;
+  enabled[Base] = level > 0;
+}
+
+void FrameCompositor::setStatusAlpha(uint8_t alpha) {
+  statusAlpha = alpha;
+}
+
+void FrameCompositor::setOverlayAlpha(uint8_t alpha) {
+  overlayAlpha = alpha;
+}
+
+void FrameCompositor::compose(CRGB* out, size_t count) {
+  if (count > NUM_LEDS_SUBWAY) count = NUM_LEDS_SUBWAY;
+  uint8_t* dst = reinterpret_cast<uint8_t*>(out);
+  const size_t bytes = count * sizeof(CRGB);
+
+  if (enabled[Status] && statusAlpha == 255) {
+    // Opaque status hides every layer below it.
+    memcpy(dst, status, bytes);
+  } else {
+    if (enabled[Base]) {
+      memcpy(dst, base, bytes);
+      LedKernels::scale(dst, bytes, baseLevel);
+    } else {
+      LedKernels::fill(dst, count, 0, 0, 0);
+    }
+    if (enabled[Arrivals]) {
+      LedKernels::lighten(dst, reinterpret_cast<const uint8_t*>(arrivals), bytes);
+    }
+    if (enabled[Status] && statusAlpha > 0) {
+      LedKernels::blend(dst, reinterpret_cast<const uint8_t*>(status), bytes, statusAlpha);
+    }
+  }
+
+  if (enabled[Overlay] && overlayAlpha > 0) {
+    LedKernels::blend(dst, reinterpret_cast<const uint8_t*>(overlay), bytes, overlayAlpha);
+  }
+}
@@ -0,0 +1,71 @@
+#include "FrameMirror.h"
+#include <cstdlib>
+#include <cstring>
+#include "Metrics.h"
+
+bool FrameMirror::enabled = false;
+bool FrameMirror::keyPending = true;
+uint16_t FrameMirror::sequence = 0;
+unsigned long FrameMirror::lastSentMs = 0;
+unsigned long FrameMirror::lastKeyMs = 0;
+const CRGB* FrameMirror::encoded = nullptr;
+size_t FrameMirror::encodedLength = 0;
+CRGB FrameMirror::sent[NUM_LEDS_SUBWAY];
+uint8_t FrameMirror::buffer[MirrorCodec::maxEncodedBytes(NUM_LEDS_SUBWAY)];
+
+bool FrameMirror::handleMessage(const char* payload, size_t length) {
+  static const char kPrefix[] = "{\"mirror\":";
+  const size_t prefixLength = sizeof(kPrefix) - 1;
+  if (length <= prefixLength || memcmp(payload, kPrefix, prefixLength) != 0) return false;
+  setEnabled(strtol(payload + prefixLength, nullptr, 10) != 0);
+  return true;
+}
+
+// Every (re)start begins with a key frame.
+void FrameMirror::setEnabled(bool on) {
+  if (on && !enabled) keyPending = true;
+  enabled = on;
+}
+
+bool FrameMirror::isEnabled() {
+  return enabled;
+}
+
+size_t FrameMirror::encode(const CRGB* leds) {
+  if (!enabled) return 0;
+  unsigned long nowMs = millis();
+  if (nowMs - lastSentMs < 1000 / MIRROR_MAX_FPS) return 0;
+  if (nowMs - lastKeyMs >= MIRROR_KEYFRAME_MS) keyPending = true;
+
+  unsigned long start = micros();
+  const uint8_t* cur = reinterpret_cast<const uint8_t*>(leds);
+  const uint8_t* prev = keyPending ? nullptr : reinterpret_cast<const uint8_t*>(sent);
+  size_t length = MirrorCodec::encode(cur, prev, NUM_LEDS_SUBWAY, sequence, buffer);
+  Metrics::mirrorEncodeTime.record(micros() - start);
+  if (length == 0) return 0;
+
+  // Attempts are rate limited too, so a failing socket isn't retried every loop.
+  lastSentMs = nowMs;
+  encoded = leds;
+  encodedLength = length;
+  return length;
+}
+
+void FrameMirror::commit(bool delivered) {
+  if (!encoded) return;
+  if (delivered) {
+    memcpy(sent, encoded, sizeof(sent));
+    sequence++;
+    if (keyPending) lastKeyMs = lastSentMs;
+    keyPending = false;
+    Metrics::mirrorFrames++;
+    Metrics::mirrorBytes += encodedLength;
+  } else {
+    keyPending = true;
+  }
+  encoded = nullptr;
+}
+
+const uint8_t* FrameMirror::data() {
+  return buffer;
+}
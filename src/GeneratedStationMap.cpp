@@ -1,460 +1,637 @@
-// Auto-generated on: 2025-09-27 14:23:37
+// Auto-generated on: 2026-10-19 06:01:44
 #include "GeneratedStationMap.h"
 
-std::map<int, Station> stationMap = {
-    {0, Station("S09", "Tottenville")},
-    {1, Station("S11", "Arthur Kill")},
-    {2, Station("S13", "Richmond Valley")},
-    {3, Station("S14", "Pleasant Plains")},
-    {4, Station("S15", "Prince's Bay")},
-    {5, Station("S16", "Huguenot")},
-    {6, Station("S17", "Annadale")},
-    {7, Station("S18", "Eltingville")},
-    {8, Station("non", "Dupe")},
-    {9, Station("S19", "Great Kills")},
-    {10, Station("S20", "Bay Terrace")},
-    {11, Station("S21", "Oakwood Heights")},
-    {12, Station("S22", "New Dorp")},
-    {13, Station("S23", "Grant City")},
-    {14, Station("S24", "Jefferson Av")},
-    {15, Station("S25", "Dongan Hills")},
-    {16, Station("S26", "Old Town")},
-    {17, Station("S27", "Grasmere")},
-    {18, Station("S28", "Clifton")},
-    {19, Station("S29", "Stapleton")},
-    {20, Station("S30", "Tompkinsville")},
-    {21, Station("S31", "St George")},
-    {22, Station("R45", "Bay Ridge-95 St")},
-    {23, Station("R44", "86 St")},
-    {24, Station("R43", "77 St")},
-    {25, Station("R42", "Bay Ridge Av")},
-    {26, Station("N02", "8 Av")},
-    {27, Station("N03", "Fort Hamilton Pkwy")},
-    {28, Station("N04", "New Utrecht Av")},
-    {29, Station("B17", "71 St")},
-    {30, Station("B18", "79 St")},
-    {31, Station("B19", "18 Av")},
-    {32, Station("B20", "20 Av")},
-    {33, Station("B21", "Bay Pkwy")},
-    {34, Station("B22", "25 Av")},
-    {35, Station("B23", "Bay 50 St")},
-    {36, Station("D43", "Coney Island-Stillwell Av")},
-    {37, Station("D42", "W 8 St-NY Aquarium")},
-    {38, Station("N10", "86 St")},
-    {39, Station("N09", "Avenue U")},
-    {40, Station("N08", "Kings Hwy")},
-    {41, Station("N07", "Bay Pkwy")},
-    {42, Station("N06", "20 Av")},
-    {43, Station("N05", "18 Av")},
-    {44, Station("B15", "55 St")},
-    {45, Station("B14", "50 St")},
-    {46, Station("B13", "Fort Hamilton Pkwy")},
-    {47, Station("B12", "9 Av")},
-    {48, Station("R41", "59 St")},
-    {49, Station("R40", "53 St")},
-    {50, Station("R39", "45 St")},
-    {51, Station("R36", "36 St")},
-    {52, Station("R35", "25 St")},
-    {53, Station("R34", "Prospect Av")},
-    {54, Station("R33", "4 Av-9 St")},
-    {55, Station("R32", "Union St")},
-    {56, Station("R31", "Atlantic Av-Barclays Ctr")},
-    {57, Station("R30", "DeKalb Av")},
-    {58, Station("235", "Atlantic Av-Barclays Ctr")},
-    {59, Station("236", "Bergen St")},
-    {60, Station("237", "Grand Army Plaza")},
-    {61, Station("F24", "7 Av")},
-    {62, Station("F25", "15 St-Prospect Park")},
-    {63, Station("F26", "Fort Hamilton Pkwy")},
-    {64, Station("F27", "Church Av")},
-    {65, Station("F29", "Ditmas Av")},
-    {66, Station("F30", "18 Av")},
-    {67, Station("F31", "Avenue I")},
-    {68, Station("F32", "Bay Pkwy")},
-    {69, Station("F33", "Avenue N")},
-    {70, Station("F34", "Avenue P")},
-    {71, Station("F35", "Kings Hwy")},
-    {72, Station("F36", "Avenue U")},
-    {73, Station("F38", "Avenue X")},
-    {74, Station("F39", "Neptune Av")},
-    {75, Station("D41", "Ocean Pkwy")},
-    {76, Station("D40", "Brighton Beach")},
-    {77, Station("D39", "Sheepshead Bay")},
-    {78, Station("D38", "Neck Rd")},
-    {79, Station("D37", "Avenue U")},
-    {80, Station("D35", "Kings Hwy")},
-    {81, Station("D34", "Avenue M")},
-    {82, Station("D33", "Avenue J")},
-    {83, Station("D32", "Avenue H")},
-    {84, Station("D31", "Newkirk Plaza")},
-    {85, Station("D30", "Cortelyou Rd")},
-    {86, Station("D29", "Beverley Rd")},
-    {87, Station("D28", "Church Av")},
-    {88, Station("D27", "Parkside Av")},
-    {89, Station("D26", "Prospect Park")},
-    {90, Station("238", "Eastern Pkwy-Brooklyn Museum")},
-    {91, Station("237", "Grand Army Plaza")},
-    {92, Station("D25", "7 Av")},
-    {93, Station("228", "Park Place")},
-    {94, Station("239", "Franklin Av-Medgar Evers College")},
-    {95, Station("241", "President St-Medgar Evers College")},
-    {96, Station("242", "Sterling St")},
-    {97, Station("243", "Winthrop St")},
-    {98, Station("244", "Church Av")},
-    {99, Station("245", "Beverly Rd")},
-    {100, Station("246", "Newkirk Av-Little Haiti")},
-    {101, Station("247", "Flatbush Av-Brooklyn College")},
-    {102, Station("H15", "Rockaway Park-Beach 116 St")},
-    {103, Station("H14", "Beach 105 St")},
-    {104, Station("H13", "Beach 98 St")},
-    {105, Station("H12", "Beach 90 St")},
-    {106, Station("H06", "Beach 67 St")},
-    {107, Station("H07", "Beach 60 St")},
-    {108, Station("H08", "Beach 44 St")},
-    {109, Station("H09", "Beach 36 St")},
-    {110, Station("H10", "Beach 25 St")},
-    {111, Station("H11", "Far Rockaway-Mott Av")},
-    {112, Station("H04", "Broad Channel")},
-    {113, Station("H04", "Broad Channel")},
-    {114, Station("H02", "Aqueduct-N Conduit Av")},
-    {115, Station("H01", "Aqueduct Racetrack")},
-    {116, Station("A65", "Ozone Park-Lefferts Blvd")},
-    {117, Station("J13", "111 St")},
-    {118, Station("J14", "104 St")},
-    {119, Station("A61", "Rockaway Blvd")},
-    {120, Station("A60", "88 St")},
-    {121, Station("A59", "80 St")},
-    {122, Station("A57", "Grant Av")},
-    {123, Station("A55", "Euclid Av")},
-    {124, Station("257", "New Lots Av")},
-    {125, Station("255", "Pennsylvania Av")},
-    {126, Station("L26", "Livonia Av")},
-    {127, Station("L27", "New Lots Av")},
-    {128, Station("L28", "East 105 St")},
-    {129, Station("L29", "Canarsie-Rockaway Pkwy")},
-    {130, Station("248", "Nostrand Av")},
-    {131, Station("248", "Nostrand Av")},
-    {132, Station("250", "Crown Hts-Utica Av")},
-    {133, Station("251", "Sutter Av-Rutland Rd")},
-    {134, Station("252", "Saratoga Av")},
-    {135, Station("253", "Rockaway Av")},
-    {136, Station("254", "Junius St")},
-    {137, Station("L25", "Sutter Av")},
-    {138, Station("L24", "Atlantic Av")},
-    {139, Station("A52", "Liberty Av")},
-    {140, Station("A53", "Van Siclen Av")},
-    {141, Station("A54", "Shepherd Av")},
-    {142, Station("G05", "Jamaica Center-Parsons/Archer")},
-    {143, Station("G06", "Sutphin Blvd-Archer Av-JFK Airport")},
-    {144, Station("J12", "121 St")},
-    {145, Station("J13", "111 St")},
-    {146, Station("J14", "104 St")},
-    {147, Station("J15", "Woodhaven Blvd")},
-    {148, Station("J16", "85 St-Forest Pkwy")},
-    {149, Station("J17", "75 St-Elderts Ln")},
-    {150, Station("J19", "Cypress Hills")},
-    {151, Station("J20", "Crescent St")},
-    {152, Station("J21", "Norwood Av")},
-    {153, Station("J22", "Cleveland St")},
-    {154, Station("J23", "Van Siclen Av")},
-    {155, Station("J24", "Alabama Av")},
-    {156, Station("J27", "Broadway Junction")},
-    {157, Station("A50", "Rockaway Av")},
-    {158, Station("A49", "Ralph Av")},
-    {159, Station("A48", "Utica Av")},
-    {160, Station("A47", "Kingston-Throop Avs")},
-    {161, Station("A46", "Nostrand Av")},
-    {162, Station("A45", "Franklin Av")},
-    {163, Station("A44", "Clinton-Washington Avs")},
-    {164, Station("A43", "Lafayette Av")},
-    {165, Station("G36", "Fulton St")},
-    {166, Station("G35", "Clinton-Washington Avs")},
-    {167, Station("G34", "Classon Av")},
-    {168, Station("G33", "Bedford-Nostrand Avs")},
-    {169, Station("G32", "Myrtle-Willoughby Avs")},
-    {170, Station("G31", "Flushing Av")},
-    {171, Station("234", "Nevins St")},
-    {172, Station("233", "Hoyt St")},
-    {173, Station("A42", "Hoyt-Schermerhorn Sts")},
-    {174, Station("F20", "Bergen St")},
-    {175, Station("F21", "Carroll St")},
-    {176, Station("F22", "Smith-9 Sts")},
-    {177, Station("232", "Borough Hall")},
-    {178, Station("423", "Borough Hall")},
-    {179, Station("A41", "Jay St-MetroTech")},
-    {180, Station("M16", "Marcy Av")},
-    {181, Station("M14", "Hewes St")},
-    {182, Station("G30", "Broadway")},
-    {183, Station("M13", "Lorimer St")},
-    {184, Station("M12", "Flushing Av")},
-    {185, Station("M11", "Myrtle Av")},
-    {186, Station("J31", "Kosciuszko St")},
-    {187, Station("J30", "Gates Av")},
-    {188, Station("J30", "Gates Av")},
-    {189, Station("J28", "Chauncey St")},
-    {190, Station("L21", "Bushwick Av-Aberdeen St")},
-    {191, Station("L20", "Wilson Av")},
-    {192, Station("L19", "Halsey St")},
-    {193, Station("M10", "Central Av")},
-    {194, Station("M09", "Knickerbocker Av")},
-    {195, Station("M08", "Myrtle-Wyckoff Avs")},
-    {196, Station("M06", "Seneca Av")},
-    {197, Station("M05", "Forest Av")},
-    {198, Station("M04", "Fresh Pond Rd")},
-    {199, Station("M01", "Middle Village-Metropolitan Av")},
-    {200, Station("L16", "DeKalb Av")},
-    {201, Station("L15", "Jefferson St")},
-    {202, Station("L14", "Morgan Av")},
-    {203, Station("L13", "Montrose Av")},
-    {204, Station("L12", "Grand St")},
-    {205, Station("L11", "Graham Av")},
-    {206, Station("L10", "Lorimer St")},
-    {207, Station("G28", "Nassau Av")},
-    {208, Station("G26", "Greenpoint Av")},
-    {209, Station("L08", "Bedford Av")},
-    {210, Station("F15", "Delancey St-Essex St")},
-    {211, Station("D22", "Grand St")},
-    {212, Station("F16", "East Broadway")},
-    {213, Station("F18", "York St")},
-    {214, Station("A40", "High St")},
-    {215, Station("231", "Clark St")},
-    {216, Station("230", "Wall St")},
-    {217, Station("M23", "Broad St")},
-    {218, Station("420", "Bowling Green")},
-    {219, Station("142", "South Ferry")},
-    {220, Station("R26", "Rector St")},
-    {221, Station("R25", "Cortlandt St")},
-    {222, Station("419", "Wall St")},
-    {223, Station("229", "Fulton St")},
-    {224, Station("640", "Brooklyn Bridge-City Hall")},
-    {225, Station("M19", "Bowery")},
-    {226, Station("F14", "2 Av")},
-    {227, Station("L06", "1 Av")},
-    {228, Station("L05", "3 Av")},
-    {229, Station("721", "Vernon Blvd-Jackson Av")},
-    {230, Station("720", "Hunters Point Av")},
-    {231, Station("719", "Court Sq")},
-    {232, Station("718", "Queensboro Plaza")},
-    {233, Station("G21", "Queens Plaza")},
-    {234, Station("716", "33 St-Rawson St")},
-    {235, Station("715", "40 St-Lowery St")},
-    {236, Station("714", "46 St-Bliss St")},
-    {237, Station("713", "52 St")},
-    {238, Station("712", "61 St-Woodside")},
-    {239, Station("711", "69 St")},
-    {240, Station("G14", "Jackson Hts-Roosevelt Av")},
-    {241, Station("G13", "Elmhurst Av")},
-    {242, Station("G12", "Grand Av-Newtown")},
-    {243, Station("G11", "Woodhaven Blvd")},
-    {244, Station("G10", "63 Dr-Rego Park")},
-    {245, Station("G09", "67 Av")},
-    {246, Station("G08", "Forest Hills-71 Av")},
-    {247, Station("F07", "75 Av")},
-    {248, Station("F06", "Kew Gardens-Union Tpke")},
-    {249, Station("F05", "Briarwood")},
-    {250, Station("G07", "Jamaica-Van Wyck")},
-    {251, Station("F01", "Jamaica-179 St")},
-    {252, Station("F02", "169 St")},
-    {253, Station("F03", "Parsons Blvd")},
-    {254, Station("F04", "Sutphin Blvd")},
-    {255, Station("701", "Flushing-Main St")},
-    {256, Station("702", "Mets-Willets Point")},
-    {257, Station("705", "111 St")},
-    {258, Station("706", "103 St-Corona Plaza")},
-    {259, Station("707", "Junction Blvd")},
-    {260, Station("708", "90 St-Elmhurst Av")},
-    {261, Station("709", "82 St-Jackson Hts")},
-    {262, Station("G15", "65 St")},
-    {263, Station("G16", "Northern Blvd")},
-    {264, Station("G18", "46 St")},
-    {265, Station("G19", "Steinway St")},
-    {266, Station("G20", "36 St")},
-    {267, Station("R01", "Astoria-Ditmars Blvd")},
-    {268, Station("R03", "Astoria Blvd")},
-    {269, Station("R04", "30 Av")},
-    {270, Station("R05", "Broadway")},
-    {271, Station("R06", "36 Av")},
-    {272, Station("R08", "39 Av-Dutch Kills")},
-    {273, Station("B04", "21 St-Queensbridge")},
-    {274, Station("B06", "Roosevelt Island")},
-    {275, Station("Q03", "72 St")},
-    {276, Station("Q04", "86 St")},
-    {277, Station("Q05", "96 St")},
-    {278, Station("621", "125 St")},
-    {279, Station("622", "116 St")},
-    {280, Station("623", "110 St")},
-    {281, Station("624", "103 St")},
-    {282, Station("625", "96 St")},
-    {283, Station("626", "86 St")},
-    {284, Station("627", "77 St")},
-    {285, Station("628", "68 St-Hunter College")},
-    {286, Station("B08", "Lexington Av/63 St")},
-    {287, Station("R11", "Lexington Av/59 St")},
-    {288, Station("F11", "Lexington Av/53 St")},
-    {289, Station("631", "Grand Central-42 St")},
-    {290, Station("632", "33 St")},
-    {291, Station("633", "28 St")},
-    {292, Station("634", "23 St")},
-    {293, Station("635", "14 St-Union Sq")},
-    {294, Station("636", "Astor Pl")},
-    {295, Station("637", "Bleecker St")},
-    {296, Station("A33", "Spring St")},
-    {297, Station("A34", "Canal St")},
-    {298, Station("R24", "City Hall")},
-    {299, Station("639", "Canal St")},
-    {300, Station("R22", "Prince St")},
-    {301, Station("R21", "8 St-NYU")},
-    {302, Station("R20", "14 St-Union Sq")},
-    {303, Station("R19", "23 St")},
-    {304, Station("R18", "28 St")},
-    {305, Station("D16", "42 St-Bryant Pk")},
-    {306, Station("F12", "5 Av/53 St")},
-    {307, Station("R13", "5 Av/59 St")},
-    {308, Station("B10", "57 St")},
-    {309, Station("D15", "47-50 Sts-Rockefeller Ctr")},
-    {310, Station("724", "5 Av")},
-    {311, Station("D17", "34 St-Herald Sq")},
-    {312, Station("D18", "23 St")},
-    {313, Station("L02", "6 Av")},
-    {314, Station("A32", "W 4 St-Wash Sq")},
-    {315, Station("A33", "Spring St")},
-    {316, Station("A34", "Canal St")},
-    {317, Station("228", "Park Place")},
-    {318, Station("139", "Rector St")},
-    {319, Station("138", "WTC Cortlandt")},
-    {320, Station("137", "Chambers St")},
-    {321, Station("136", "Franklin St")},
-    {322, Station("135", "Canal St")},
-    {323, Station("134", "Houston St")},
-    {324, Station("133", "Christopher St-Stonewall")},
-    {325, Station("132", "14 St")},
-    {326, Station("131", "18 St")},
-    {327, Station("130", "23 St")},
-    {328, Station("128", "34 St-Penn Station")},
-    {329, Station("127", "Times Sq-42 St")},
-    {330, Station("R16", "Times Sq-42 St")},
-    {331, Station("725", "Times Sq-42 St")},
-    {332, Station("R15", "49 St")},
-    {333, Station("R14", "57 St-7 Av")},
-    {334, Station("D14", "7 Av")},
-    {335, Station("126", "50 St")},
-    {336, Station("A25", "50 St")},
-    {337, Station("A27", "42 St-Port Authority Bus Terminal")},
-    {338, Station("A28", "34 St-Penn Station")},
-    {339, Station("A30", "23 St")},
-    {340, Station("A31", "14 St")},
-    {341, Station("726", "34 St-Hudson Yards")},
-    {342, Station("124", "66 St-Lincoln Center")},
-    {343, Station("123", "72 St")},
-    {344, Station("122", "79 St")},
-    {345, Station("121", "86 St")},
-    {346, Station("120", "96 St")},
-    {347, Station("119", "103 St")},
-    {348, Station("118", "Cathedral Pkwy (110 St)")},
-    {349, Station("117", "116 St-Columbia University")},
-    {350, Station("116", "125 St")},
-    {351, Station("115", "137 St-City College")},
-    {352, Station("114", "145 St")},
-    {353, Station("113", "157 St")},
-    {354, Station("112", "168 St-Washington Hts")},
-    {355, Station("A07", "175 St")},
-    {356, Station("A06", "181 St")},
-    {357, Station("A05", "190 St")},
-    {358, Station("A03", "Dyckman St")},
-    {359, Station("A02", "Inwood-207 St")},
-    {360, Station("101", "Van Cortlandt Park-242 St")},
-    {361, Station("103", "238 St")},
-    {362, Station("104", "231 St")},
-    {363, Station("106", "Marble Hill-225 St")},
-    {364, Station("107", "215 St")},
-    {365, Station("108", "207 St")},
-    {366, Station("109", "Dyckman St")},
-    {367, Station("110", "191 St")},
-    {368, Station("111", "181 St")},
-    {369, Station("A10", "163 St-Amsterdam Av")},
-    {370, Station("A11", "155 St")},
-    {371, Station("A12", "145 St")},
-    {372, Station("A14", "135 St")},
-    {373, Station("A15", "125 St")},
-    {374, Station("A16", "116 St")},
-    {375, Station("A17", "Cathedral Pkwy (110 St)")},
-    {376, Station("A18", "103 St")},
-    {377, Station("A19", "96 St")},
-    {378, Station("A20", "86 St")},
-    {379, Station("A21", "81 St-Museum of Natural History")},
-    {380, Station("A22", "72 St")},
-    {381, Station("A25", "50 St")},
-    {382, Station("D12", "155 St")},
-    {383, Station("227", "Central Park North (110 St)")},
-    {384, Station("226", "116 St")},
-    {385, Station("225", "125 St")},
-    {386, Station("224", "135 St")},
-    {387, Station("302", "145 St")},
-    {388, Station("301", "Harlem-148 St")},
-    {389, Station("416", "138 St-Grand Concourse")},
-    {390, Station("416", "138 St-Grand Concourse")},
-    {391, Station("414", "161 St-Yankee Stadium")},
-    {392, Station("413", "167 St")},
-    {393, Station("412", "170 St")},
-    {394, Station("411", "Mt Eden Av")},
-    {395, Station("410", "176 St")},
-    {396, Station("409", "Burnside Av")},
-    {397, Station("408", "183 St")},
-    {398, Station("407", "Fordham Rd")},
-    {399, Station("406", "Kingsbridge Rd")},
-    {400, Station("405", "Bedford Park Blvd-Lehman College")},
-    {401, Station("402", "Mosholu Pkwy")},
-    {402, Station("401", "Woodlawn")},
-    {403, Station("D01", "Norwood-205 St")},
-    {404, Station("D03", "Bedford Park Blvd")},
-    {405, Station("D04", "Kingsbridge Rd")},
-    {406, Station("D05", "Fordham Rd")},
-    {407, Station("D06", "182-183 Sts")},
-    {408, Station("D06", "182-183 Sts")},
-    {409, Station("D08", "174-175 Sts")},
-    {410, Station("D09", "170 St")},
-    {411, Station("D10", "167 St")},
-    {412, Station("222", "149 St-Grand Concourse")},
-    {413, Station("221", "3 Av-149 St")},
-    {414, Station("619", "3 Av-138 St")},
-    {415, Station("618", "Brook Av")},
-    {416, Station("220", "Jackson Av")},
-    {417, Station("219", "Prospect Av")},
-    {418, Station("218", "Intervale Av")},
-    {419, Station("217", "Simpson St")},
-    {420, Station("216", "Freeman St")},
-    {421, Station("215", "174 St")},
-    {422, Station("214", "West Farms Sq-E Tremont Av")},
-    {423, Station("213", "E 180 St")},
-    {424, Station("212", "Bronx Park East")},
-    {425, Station("211", "Pelham Pkwy")},
-    {426, Station("210", "Allerton Av")},
-    {427, Station("209", "Burke Av")},
-    {428, Station("208", "Gun Hill Rd")},
-    {429, Station("207", "219 St")},
-    {430, Station("206", "225 St")},
-    {431, Station("205", "233 St")},
-    {432, Station("204", "Nereid Av")},
-    {433, Station("201", "Wakefield-241 St")},
-    {434, Station("501", "Eastchester-Dyre Av")},
-    {435, Station("502", "Baychester Av")},
-    {436, Station("503", "Gun Hill Rd")},
-    {437, Station("504", "Pelham Pkwy")},
-    {438, Station("505", "Morris Park")},
-    {439, Station("617", "Cypress Av")},
-    {440, Station("616", "E 143 St-St Mary's St")},
-    {441, Station("615", "E 149 St")},
-    {442, Station("614", "Longwood Av")},
-    {443, Station("613", "Hunts Point Av")},
-    {444, Station("612", "Whitlock Av")},
-    {445, Station("611", "Elder Av")},
-    {446, Station("610", "Morrison Av-Soundview")},
-    {447, Station("609", "St Lawrence Av")},
-    {448, Station("608", "Parkchester")},
-    {449, Station("607", "Castle Hill Av")},
-    {450, Station("606", "Zerega Av")},
-    {451, Station("604", "Westchester Sq-E Tremont Av")},
-    {452, Station("603", "Middletown Rd")},
-    {453, Station("602", "Buhre Av")},
-    {454, Station("601", "Pelham Bay Park")},
+const char* const generatedStationIds[GENERATED_STATION_COUNT] = {
+    "101", "103", "104", "106", "107", "108", "109", "110", "111", "112",
+    "113", "114", "115", "116", "117", "118", "119", "120", "121", "122",
+    "123", "124", "126", "127", "128", "130", "131", "132", "133", "134",
+    "135", "136", "137", "138", "139", "142", "201", "204", "205", "206",
+    "207", "208", "209", "210", "211", "212", "213", "214", "215", "216",
+    "217", "218", "219", "220", "221", "222", "224", "225", "226", "227",
+    "228", "229", "230", "231", "232", "233", "234", "235", "236", "237",
+    "238", "239", "241", "242", "243", "244", "245", "246", "247", "248",
+    "250", "251", "252", "253", "254", "255", "257", "301", "302", "401",
+    "402", "405", "406", "407", "408", "409", "410", "411", "412", "413",
+    "414", "416", "419", "420", "423", "501", "502", "503", "504", "505",
+    "601", "602", "603", "604", "606", "607", "608", "609", "610", "611",
+    "612", "613", "614", "615", "616", "617", "618", "619", "621", "622",
+    "623", "624", "625", "626", "627", "628", "631", "632", "633", "634",
+    "635", "636", "637", "639", "640", "701", "702", "705", "706", "707",
+    "708", "709", "711", "712", "713", "714", "715", "716", "718", "719",
+    "720", "721", "724", "725", "726", "A02", "A03", "A05", "A06", "A07",
+    "A10", "A11", "A12", "A14", "A15", "A16", "A17", "A18", "A19", "A20",
+    "A21", "A22", "A25", "A27", "A28", "A30", "A31", "A32", "A33", "A34",
+    "A40", "A41", "A42", "A43", "A44", "A45", "A46", "A47", "A48", "A49",
+    "A50", "A52", "A53", "A54", "A55", "A57", "A59", "A60", "A61", "A65",
+    "B04", "B06", "B08", "B10", "B12", "B13", "B14", "B15", "B17", "B18",
+    "B19", "B20", "B21", "B22", "B23", "D01", "D03", "D04", "D05", "D06",
+    "D08", "D09", "D10", "D12", "D14", "D15", "D16", "D17", "D18", "D22",
+    "D25", "D26", "D27", "D28", "D29", "D30", "D31", "D32", "D33", "D34",
+    "D35", "D37", "D38", "D39", "D40", "D41", "D42", "D43", "F01", "F02",
+    "F03", "F04", "F05", "F06", "F07", "F11", "F12", "F14", "F15", "F16",
+    "F18", "F20", "F21", "F22", "F24", "F25", "F26", "F27", "F29", "F30",
+    "F31", "F32", "F33", "F34", "F35", "F36", "F38", "F39", "G05", "G06",
+    "G07", "G08", "G09", "G10", "G11", "G12", "G13", "G14", "G15", "G16",
+    "G18", "G19", "G20", "G21", "G26", "G28", "G30", "G31", "G32", "G33",
+    "G34", "G35", "G36", "H01", "H02", "H04", "H06", "H07", "H08", "H09",
+    "H10", "H11", "H12", "H13", "H14", "H15", "J12", "J13", "J14", "J15",
+    "J16", "J17", "J19", "J20", "J21", "J22", "J23", "J24", "J27", "J28",
+    "J30", "J31", "L02", "L05", "L06", "L08", "L10", "L11", "L12", "L13",
+    "L14", "L15", "L16", "L19", "L20", "L21", "L24", "L25", "L26", "L27",
+    "L28", "L29", "M01", "M04", "M05", "M06", "M08", "M09", "M10", "M11",
+    "M12", "M13", "M14", "M16", "M19", "M23", "N02", "N03", "N04", "N05",
+    "N06", "N07", "N08", "N09", "N10", "Q03", "Q04", "Q05", "R01", "R03",
+    "R04", "R05", "R06", "R08", "R11", "R13", "R14", "R15", "R16", "R18",
+    "R19", "R20", "R21", "R22", "R24", "R25", "R26", "R30", "R31", "R32",
+    "R33", "R34", "R35", "R36", "R39", "R40", "R41", "R42", "R43", "R44",
+    "R45", "S09", "S11", "S13", "S14", "S15", "S16", "S17", "S18", "S19",
+    "S20", "S21", "S22", "S23", "S24", "S25", "S26", "S27", "S28", "S29",
+    "S30", "S31",
+};
+
+const char* const generatedStationNames[GENERATED_STATION_COUNT] = {
+    "Van Cortlandt Park-242 St",
+    "238 St",
+    "231 St",
+    "Marble Hill-225 St",
+    "215 St",
+    "207 St",
+    "Dyckman St",
+    "191 St",
+    "181 St",
+    "168 St-Washington Hts",
+    "157 St",
+    "145 St",
+    "137 St-City College",
+    "125 St",
+    "116 St-Columbia University",
+    "Cathedral Pkwy (110 St)",
+    "103 St",
+    "96 St",
+    "86 St",
+    "79 St",
+    "72 St",
+    "66 St-Lincoln Center",
+    "50 St",
+    "Times Sq-42 St",
+    "34 St-Penn Station",
+    "23 St",
+    "18 St",
+    "14 St",
+    "Christopher St-Stonewall",
+    "Houston St",
+    "Canal St",
+    "Franklin St",
+    "Chambers St",
+    "WTC Cortlandt",
+    "Rector St",
+    "South Ferry",
+    "Wakefield-241 St",
+    "Nereid Av",
+    "233 St",
+    "225 St",
+    "219 St",
+    "Gun Hill Rd",
+    "Burke Av",
+    "Allerton Av",
+    "Pelham Pkwy",
+    "Bronx Park East",
+    "E 180 St",
+    "West Farms Sq-E Tremont Av",
+    "174 St",
+    "Freeman St",
+    "Simpson St",
+    "Intervale Av",
+    "Prospect Av",
+    "Jackson Av",
+    "3 Av-149 St",
+    "149 St-Grand Concourse",
+    "135 St",
+    "125 St",
+    "116 St",
+    "Central Park North (110 St)",
+    "Park Place",
+    "Fulton St",
+    "Wall St",
+    "Clark St",
+    "Borough Hall",
+    "Hoyt St",
+    "Nevins St",
+    "Atlantic Av-Barclays Ctr",
+    "Bergen St",
+    "Grand Army Plaza",
+    "Eastern Pkwy-Brooklyn Museum",
+    "Franklin Av-Medgar Evers College",
+    "President St-Medgar Evers College",
+    "Sterling St",
+    "Winthrop St",
+    "Church Av",
+    "Beverly Rd",
+    "Newkirk Av-Little Haiti",
+    "Flatbush Av-Brooklyn College",
+    "Nostrand Av",
+    "Crown Hts-Utica Av",
+    "Sutter Av-Rutland Rd",
+    "Saratoga Av",
+    "Rockaway Av",
+    "Junius St",
+    "Pennsylvania Av",
+    "New Lots Av",
+    "Harlem-148 St",
+    "145 St",
+    "Woodlawn",
+    "Mosholu Pkwy",
+    "Bedford Park Blvd-Lehman College",
+    "Kingsbridge Rd",
+    "Fordham Rd",
+    "183 St",
+    "Burnside Av",
+    "176 St",
+    "Mt Eden Av",
+    "170 St",
+    "167 St",
+    "161 St-Yankee Stadium",
+    "138 St-Grand Concourse",
+    "Wall St",
+    "Bowling Green",
+    "Borough Hall",
+    "Eastchester-Dyre Av",
+    "Baychester Av",
+    "Gun Hill Rd",
+    "Pelham Pkwy",
+    "Morris Park",
+    "Pelham Bay Park",
+    "Buhre Av",
+    "Middletown Rd",
+    "Westchester Sq-E Tremont Av",
+    "Zerega Av",
+    "Castle Hill Av",
+    "Parkchester",
+    "St Lawrence Av",
+    "Morrison Av-Soundview",
+    "Elder Av",
+    "Whitlock Av",
+    "Hunts Point Av",
+    "Longwood Av",
+    "E 149 St",
+    "E 143 St-St Mary's St",
+    "Cypress Av",
+    "Brook Av",
+    "3 Av-138 St",
+    "125 St",
+    "116 St",
+    "110 St",
+    "103 St",
+    "96 St",
+    "86 St",
+    "77 St",
+    "68 St-Hunter College",
+    "Grand Central-42 St",
+    "33 St",
+    "28 St",
+    "23 St",
+    "14 St-Union Sq",
+    "Astor Pl",
+    "Bleecker St",
+    "Canal St",
+    "Brooklyn Bridge-City Hall",
+    "Flushing-Main St",
+    "Mets-Willets Point",
+    "111 St",
+    "103 St-Corona Plaza",
+    "Junction Blvd",
+    "90 St-Elmhurst Av",
+    "82 St-Jackson Hts",
+    "69 St",
+    "61 St-Woodside",
+    "52 St",
+    "46 St-Bliss St",
+    "40 St-Lowery St",
+    "33 St-Rawson St",
+    "Queensboro Plaza",
+    "Court Sq",
+    "Hunters Point Av",
+    "Vernon Blvd-Jackson Av",
+    "5 Av",
+    "Times Sq-42 St",
+    "34 St-Hudson Yards",
+    "Inwood-207 St",
+    "Dyckman St",
+    "190 St",
+    "181 St",
+    "175 St",
+    "163 St-Amsterdam Av",
+    "155 St",
+    "145 St",
+    "135 St",
+    "125 St",
+    "116 St",
+    "Cathedral Pkwy (110 St)",
+    "103 St",
+    "96 St",
+    "86 St",
+    "81 St-Museum of Natural History",
+    "72 St",
+    "50 St",
+    "42 St-Port Authority Bus Terminal",
+    "34 St-Penn Station",
+    "23 St",
+    "14 St",
+    "W 4 St-Wash Sq",
+    "Spring St",
+    "Canal St",
+    "High St",
+    "Jay St-MetroTech",
+    "Hoyt-Schermerhorn Sts",
+    "Lafayette Av",
+    "Clinton-Washington Avs",
+    "Franklin Av",
+    "Nostrand Av",
+    "Kingston-Throop Avs",
+    "Utica Av",
+    "Ralph Av",
+    "Rockaway Av",
+    "Liberty Av",
+    "Van Siclen Av",
+    "Shepherd Av",
+    "Euclid Av",
+    "Grant Av",
+    "80 St",
+    "88 St",
+    "Rockaway Blvd",
+    "Ozone Park-Lefferts Blvd",
+    "21 St-Queensbridge",
+    "Roosevelt Island",
+    "Lexington Av/63 St",
+    "57 St",
+    "9 Av",
+    "Fort Hamilton Pkwy",
+    "50 St",
+    "55 St",
+    "71 St",
+    "79 St",
+    "18 Av",
+    "20 Av",
+    "Bay Pkwy",
+    "25 Av",
+    "Bay 50 St",
+    "Norwood-205 St",
+    "Bedford Park Blvd",
+    "Kingsbridge Rd",
+    "Fordham Rd",
+    "182-183 Sts",
+    "174-175 Sts",
+    "170 St",
+    "167 St",
+    "155 St",
+    "7 Av",
+    "47-50 Sts-Rockefeller Ctr",
+    "42 St-Bryant Pk",
+    "34 St-Herald Sq",
+    "23 St",
+    "Grand St",
+    "7 Av",
+    "Prospect Park",
+    "Parkside Av",
+    "Church Av",
+    "Beverley Rd",
+    "Cortelyou Rd",
+    "Newkirk Plaza",
+    "Avenue H",
+    "Avenue J",
+    "Avenue M",
+    "Kings Hwy",
+    "Avenue U",
+    "Neck Rd",
+    "Sheepshead Bay",
+    "Brighton Beach",
+    "Ocean Pkwy",
+    "W 8 St-NY Aquarium",
+    "Coney Island-Stillwell Av",
+    "Jamaica-179 St",
+    "169 St",
+    "Parsons Blvd",
+    "Sutphin Blvd",
+    "Briarwood",
+    "Kew Gardens-Union Tpke",
+    "75 Av",
+    "Lexington Av/53 St",
+    "5 Av/53 St",
+    "2 Av",
+    "Delancey St-Essex St",
+    "East Broadway",
+    "York St",
+    "Bergen St",
+    "Carroll St",
+    "Smith-9 Sts",
+    "7 Av",
+    "15 St-Prospect Park",
+    "Fort Hamilton Pkwy",
+    "Church Av",
+    "Ditmas Av",
+    "18 Av",
+    "Avenue I",
+    "Bay Pkwy",
+    "Avenue N",
+    "Avenue P",
+    "Kings Hwy",
+    "Avenue U",
+    "Avenue X",
+    "Neptune Av",
+    "Jamaica Center-Parsons/Archer",
+    "Sutphin Blvd-Archer Av-JFK Airport",
+    "Jamaica-Van Wyck",
+    "Forest Hills-71 Av",
+    "67 Av",
+    "63 Dr-Rego Park",
+    "Woodhaven Blvd",
+    "Grand Av-Newtown",
+    "Elmhurst Av",
+    "Jackson Hts-Roosevelt Av",
+    "65 St",
+    "Northern Blvd",
+    "46 St",
+    "Steinway St",
+    "36 St",
+    "Queens Plaza",
+    "Greenpoint Av",
+    "Nassau Av",
+    "Broadway",
+    "Flushing Av",
+    "Myrtle-Willoughby Avs",
+    "Bedford-Nostrand Avs",
+    "Classon Av",
+    "Clinton-Washington Avs",
+    "Fulton St",
+    "Aqueduct Racetrack",
+    "Aqueduct-N Conduit Av",
+    "Broad Channel",
+    "Beach 67 St",
+    "Beach 60 St",
+    "Beach 44 St",
+    "Beach 36 St",
+    "Beach 25 St",
+    "Far Rockaway-Mott Av",
+    "Beach 90 St",
+    "Beach 98 St",
+    "Beach 105 St",
+    "Rockaway Park-Beach 116 St",
+    "121 St",
+    "111 St",
+    "104 St",
+    "Woodhaven Blvd",
+    "85 St-Forest Pkwy",
+    "75 St-Elderts Ln",
+    "Cypress Hills",
+    "Crescent St",
+    "Norwood Av",
+    "Cleveland St",
+    "Van Siclen Av",
+    "Alabama Av",
+    "Broadway Junction",
+    "Chauncey St",
+    "Gates Av",
+    "Kosciuszko St",
+    "6 Av",
+    "3 Av",
+    "1 Av",
+    "Bedford Av",
+    "Lorimer St",
+    "Graham Av",
+    "Grand St",
+    "Montrose Av",
+    "Morgan Av",
+    "Jefferson St",
+    "DeKalb Av",
+    "Halsey St",
+    "Wilson Av",
+    "Bushwick Av-Aberdeen St",
+    "Atlantic Av",
+    "Sutter Av",
+    "Livonia Av",
+    "New Lots Av",
+    "East 105 St",
+    "Canarsie-Rockaway Pkwy",
+    "Middle Village-Metropolitan Av",
+    "Fresh Pond Rd",
+    "Forest Av",
+    "Seneca Av",
+    "Myrtle-Wyckoff Avs",
+    "Knickerbocker Av",
+    "Central Av",
+    "Myrtle Av",
+    "Flushing Av",
+    "Lorimer St",
+    "Hewes St",
+    "Marcy Av",
+    "Bowery",
+    "Broad St",
+    "8 Av",
+    "Fort Hamilton Pkwy",
+    "New Utrecht Av",
+    "18 Av",
+    "20 Av",
+    "Bay Pkwy",
+    "Kings Hwy",
+    "Avenue U",
+    "86 St",
+    "72 St",
+    "86 St",
+    "96 St",
+    "Astoria-Ditmars Blvd",
+    "Astoria Blvd",
+    "30 Av",
+    "Broadway",
+    "36 Av",
+    "39 Av-Dutch Kills",
+    "Lexington Av/59 St",
+    "5 Av/59 St",
+    "57 St-7 Av",
+    "49 St",
+    "Times Sq-42 St",
+    "28 St",
+    "23 St",
+    "14 St-Union Sq",
+    "8 St-NYU",
+    "Prince St",
+    "City Hall",
+    "Cortlandt St",
+    "Rector St",
+    "DeKalb Av",
+    "Atlantic Av-Barclays Ctr",
+    "Union St",
+    "4 Av-9 St",
+    "Prospect Av",
+    "25 St",
+    "36 St",
+    "45 St",
+    "53 St",
+    "59 St",
+    "Bay Ridge Av",
+    "77 St",
+    "86 St",
+    "Bay Ridge-95 St",
+    "Tottenville",
+    "Arthur Kill",
+    "Richmond Valley",
+    "Pleasant Plains",
+    "Prince's Bay",
+    "Huguenot",
+    "Annadale",
+    "Eltingville",
+    "Great Kills",
+    "Bay Terrace",
+    "Oakwood Heights",
+    "New Dorp",
+    "Grant City",
+    "Jefferson Av",
+    "Dongan Hills",
+    "Old Town",
+    "Grasmere",
+    "Clifton",
+    "Stapleton",
+    "Tompkinsville",
+    "St George",
+};
+
+const uint16_t generatedStationLedStart[GENERATED_STATION_COUNT + 1] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 62, 63, 64,
+    65, 66, 67, 68, 69, 70, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81,
+    83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98,
+    99, 100, 101, 102, 103, 104, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115,
+    116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131,
+    132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147,
+    148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163,
+    164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179,
+    180, 181, 182, 183, 184, 185, 186, 188, 189, 190, 191, 192, 193, 195, 197, 198,
+    199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214,
+    215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230,
+    231, 232, 233, 234, 235, 236, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247,
+    248, 249, 250, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260, 261, 262, 263,
+    264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 277, 278, 279,
+    280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 295,
+    296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309, 310, 311,
+    312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 325, 326, 327, 328,
+    329, 330, 331, 332, 333, 334, 335, 336, 338, 340, 341, 342, 343, 344, 345, 346,
+    347, 348, 349, 350, 351, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363,
+    364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379,
+    380, 381, 382, 383, 384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395,
+    396, 397, 398, 399, 400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411,
+    412, 413, 414, 415, 416, 417, 418, 419, 420, 421, 422, 423, 424, 425, 426, 427,
+    428, 429, 430, 431, 432, 433, 434, 435, 436, 437, 438, 439, 440, 441, 442, 443,
+    444, 445, 446, 447, 448, 449, 450, 451, 452, 453, 454,
+};
+
+const uint16_t generatedStationLeds[GENERATED_FANOUT_COUNT] = {
+    360, 361, 362, 363, 364, 365, 366, 367, 368, 354, 353, 352, 351, 350, 349, 348,
+    347, 346, 345, 344, 343, 342, 335, 329, 328, 327, 326, 325, 324, 323, 322, 321,
+    320, 319, 318, 219, 433, 432, 431, 430, 429, 428, 427, 426, 425, 424, 423, 422,
+    421, 420, 419, 418, 417, 416, 413, 412, 386, 385, 384, 383, 93, 317, 223, 216,
+    215, 177, 172, 171, 58, 59, 60, 91, 90, 94, 95, 96, 97, 98, 99, 100,
+    101, 130, 131, 132, 133, 134, 135, 136, 125, 124, 388, 387, 402, 401, 400, 399,
+    398, 397, 396, 395, 394, 393, 392, 391, 389, 390, 222, 218, 178, 434, 435, 436,
+    437, 438, 454, 453, 452, 451, 450, 449, 448, 447, 446, 445, 444, 443, 442, 441,
+    440, 439, 415, 414, 278, 279, 280, 281, 282, 283, 284, 285, 289, 290, 291, 292,
+    293, 294, 295, 299, 224, 255, 256, 257, 258, 259, 260, 261, 239, 238, 237, 236,
+    235, 234, 232, 231, 230, 229, 310, 331, 341, 359, 358, 357, 356, 355, 369, 370,
+    371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 336, 381, 337, 338, 339, 340,
+    314, 296, 315, 297, 316, 214, 179, 173, 164, 163, 162, 161, 160, 159, 158, 157,
+    139, 140, 141, 123, 122, 121, 120, 119, 116, 273, 274, 286, 308, 47, 46, 45,
+    44, 29, 30, 31, 32, 33, 34, 35, 403, 404, 405, 406, 407, 408, 409, 410,
+    411, 382, 334, 309, 305, 311, 312, 211, 92, 89, 88, 87, 86, 85, 84, 83,
+    82, 81, 80, 79, 78, 77, 76, 75, 37, 36, 251, 252, 253, 254, 249, 248,
+    247, 288, 306, 226, 210, 212, 213, 174, 175, 176, 61, 62, 63, 64, 65, 66,
+    67, 68, 69, 70, 71, 72, 73, 74, 142, 143, 250, 246, 245, 244, 243, 242,
+    241, 240, 262, 263, 264, 265, 266, 233, 208, 207, 182, 170, 169, 168, 167, 166,
+    165, 115, 114, 112, 113, 106, 107, 108, 109, 110, 111, 105, 104, 103, 102, 144,
+    117, 145, 118, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 189, 187,
+    188, 186, 313, 228, 227, 209, 206, 205, 204, 203, 202, 201, 200, 192, 191, 190,
+    138, 137, 126, 127, 128, 129, 199, 198, 197, 196, 195, 194, 193, 185, 184, 183,
+    181, 180, 225, 217, 26, 27, 28, 43, 42, 41, 40, 39, 38, 275, 276, 277,
+    267, 268, 269, 270, 271, 272, 287, 307, 333, 332, 330, 304, 303, 302, 301, 300,
+    298, 221, 220, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 25, 24, 23,
+    22, 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21,
+};
+
+const uint16_t generatedLedComplex[GENERATED_LED_COUNT] = {
+    410, 411, 412, 413, 414, 415, 416, 417, 65535, 418, 419, 420, 421, 422, 423, 424,
+    425, 426, 427, 428, 429, 430, 409, 408, 407, 406, 372, 373, 218, 219, 220, 221,
+    222, 223, 224, 225, 257, 256, 379, 378, 377, 376, 375, 374, 217, 216, 215, 214,
+    405, 404, 403, 402, 401, 400, 273, 399, 67, 398, 67, 68, 69, 274, 275, 276,
+    277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 255, 254, 253, 252, 251,
+    250, 249, 248, 247, 246, 245, 244, 243, 242, 241, 70, 69, 240, 60, 71, 72,
+    73, 74, 75, 76, 77, 78, 325, 324, 323, 322, 316, 317, 318, 319, 320, 321,
+    315, 315, 314, 313, 210, 327, 328, 209, 208, 207, 206, 205, 86, 85, 84, 356,
+    357, 358, 79, 79, 80, 81, 82, 83, 84, 355, 354, 202, 203, 204, 288, 289,
+    326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 201, 200, 199, 198,
+    197, 196, 195, 194, 193, 312, 311, 310, 309, 308, 307, 66, 65, 192, 270, 271,
+    272, 64, 64, 191, 369, 368, 306, 367, 366, 365, 340, 339, 339, 338, 353, 352,
+    351, 364, 363, 350, 362, 361, 360, 359, 349, 348, 347, 346, 345, 344, 305, 304,
+    303, 343, 267, 239, 268, 269, 190, 63, 62, 371, 103, 35, 397, 60, 102, 61,
+    145, 370, 266, 342, 341, 163, 162, 161, 160, 302, 159, 158, 157, 156, 155, 154,
+    153, 296, 295, 294, 293, 292, 291, 264, 263, 262, 290, 258, 259, 260, 261, 146,
+    147, 148, 149, 150, 151, 152, 297, 298, 299, 300, 301, 383, 384, 385, 386, 387,
+    388, 211, 212, 380, 381, 382, 127, 128, 129, 130, 131, 132, 133, 134, 135, 135,
+    136, 137, 138, 139, 140, 141, 142, 143, 188, 189, 396, 144, 395, 394, 141, 393,
+    392, 164, 265, 389, 213, 236, 164, 237, 238, 27, 187, 188, 189, 60, 34, 33,
+    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 23, 23, 391, 390, 235, 22,
+    183, 23, 184, 185, 186, 165, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12,
+    11, 10, 9, 170, 169, 168, 167, 166, 0, 1, 2, 3, 4, 5, 6, 7,
+    8, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 234, 59,
+    58, 57, 56, 88, 87, 101, 101, 100, 99, 98, 97, 96, 95, 94, 93, 92,
+    91, 90, 89, 226, 227, 228, 229, 230, 230, 231, 232, 233, 55, 54, 126, 125,
+    53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38,
+    37, 36, 104, 105, 106, 107, 108, 124, 123, 122, 121, 120, 119, 118, 117, 116,
+    115, 114, 113, 112, 111, 110, 109,
+};
+
+const char generatedComplexIds[GENERATED_COMPLEX_COUNT][4] = {
+    "101", "103", "104", "106", "107", "108", "109", "110", "111", "112",
+    "113", "114", "115", "116", "117", "118", "119", "120", "121", "122",
+    "123", "124", "126", "127", "128", "130", "131", "132", "133", "134",
+    "135", "136", "137", "138", "139", "142", "201", "204", "205", "206",
+    "207", "208", "209", "210", "211", "212", "213", "214", "215", "216",
+    "217", "218", "219", "220", "221", "222", "224", "225", "226", "227",
+    "228", "229", "230", "231", "232", "233", "234", "235", "236", "237",
+    "238", "239", "241", "242", "243", "244", "245", "246", "247", "248",
+    "250", "251", "252", "253", "254", "255", "257", "301", "302", "401",
+    "402", "405", "406", "407", "408", "409", "410", "411", "412", "413",
+    "414", "416", "419", "420", "501", "502", "503", "504", "505", "601",
+    "602", "603", "604", "606", "607", "608", "609", "610", "611", "612",
+    "613", "614", "615", "616", "617", "618", "619", "621", "622", "623",
+    "624", "625", "626", "627", "628", "629", "630", "631", "632", "633",
+    "634", "635", "636", "637", "639", "640", "701", "702", "705", "706",
+    "707", "708", "709", "710", "711", "712", "713", "714", "715", "716",
+    "718", "719", "720", "721", "724", "726", "A02", "A03", "A05", "A06",
+    "A07", "A10", "A11", "A12", "A14", "A15", "A16", "A17", "A18", "A19",
+    "A20", "A21", "A22", "A25", "A28", "A30", "A31", "A32", "A33", "A34",
+    "A40", "A41", "A42", "A43", "A44", "A45", "A46", "A47", "A48", "A49",
+    "A50", "A51", "A52", "A53", "A54", "A55", "A57", "A59", "A60", "A61",
+    "A65", "B04", "B06", "B10", "B12", "B13", "B14", "B15", "B16", "B17",
+    "B18", "B19", "B20", "B21", "B22", "B23", "D01", "D03", "D04", "D05",
+    "D06", "D08", "D09", "D10", "D12", "D14", "D15", "D17", "D18", "D22",
+    "D25", "D26", "D27", "D28", "D29", "D30", "D31", "D32", "D33", "D34",
+    "D35", "D37", "D38", "D39", "D40", "D41", "D42", "D43", "F01", "F02",
+    "F03", "F04", "F05", "F06", "F07", "F12", "F14", "F15", "F16", "F18",
+    "F20", "F21", "F22", "F23", "F24", "F25", "F26", "F27", "F29", "F30",
+    "F31", "F32", "F33", "F34", "F35", "F36", "F38", "F39", "G05", "G06",
+    "G07", "G08", "G09", "G10", "G11", "G12", "G13", "G15", "G16", "G18",
+    "G19", "G20", "G21", "G26", "G28", "G29", "G30", "G31", "G32", "G33",
+    "G34", "G35", "G36", "H01", "H02", "H04", "H06", "H07", "H08", "H09",
+    "H10", "H11", "H12", "H13", "H14", "H15", "J12", "J13", "J14", "J15",
+    "J16", "J17", "J19", "J20", "J21", "J22", "J23", "J24", "J28", "J30",
+    "J31", "L05", "L06", "L08", "L11", "L12", "L13", "L14", "L15", "L16",
+    "L17", "L19", "L20", "L21", "L24", "L25", "L27", "L28", "L29", "M01",
+    "M04", "M05", "M06", "M09", "M10", "M11", "M12", "M13", "M14", "M16",
+    "M19", "M23", "N02", "N03", "N05", "N06", "N07", "N08", "N09", "N10",
+    "Q03", "Q04", "Q05", "R01", "R03", "R04", "R05", "R06", "R08", "R13",
+    "R14", "R15", "R18", "R19", "R21", "R22", "R24", "R26", "R30", "R32",
+    "R34", "R35", "R36", "R39", "R40", "R41", "R42", "R43", "R44", "R45",
+    "S09", "S11", "S13", "S14", "S15", "S16", "S17", "S18", "S19", "S20",
+    "S21", "S22", "S23", "S24", "S25", "S26", "S27", "S28", "S29", "S30",
+    "S31",
 };
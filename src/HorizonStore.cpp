@@ -0,0 +1,226 @@
+#include "HorizonStore.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cstring>
+#include "MemoryPolicy.h"
+#include "StationMap.h"
+
+namespace {
+// Slack below now kept representable, for trains still in their 30 s window.
+constexpr time_t kTrailSeconds = 31;
+// Rebase once the epoch trails now by this much; the newest entry
+// (now + HORIZON_SECONDS) must still fit in kMaxOffset.
+constexpr time_t kRebaseAfter = HorizonStore::kMaxOffset - HORIZON_SECONDS - kTrailSeconds - 1;
+
+static_assert(HORIZON_SECONDS + kTrailSeconds + 60 <= HorizonStore::kMaxOffset,
+              "HORIZON_SECONDS does not fit the entry offset bits");
+static_assert(HORIZON_CAPACITY <= 65535, "HorizonSlot::start is 16 bits");
+static_assert(HORIZON_MAX_PER_STATION <= 255, "HorizonSlot counts are 8 bits");
+}
+
+uint16_t* HorizonStore::pool = nullptr;
+size_t HorizonStore::capacity = 0;
+HorizonSlot* HorizonStore::slots = nullptr;
+uint8_t* HorizonStore::feedMask = nullptr;
+size_t HorizonStore::slotCount = 0;
+uint16_t* HorizonStore::order = nullptr;
+size_t HorizonStore::end = 0;
+size_t HorizonStore::live = 0;
+uint32_t HorizonStore::droppedEntries = 0;
+time_t HorizonStore::epoch = 0;
+
+// The pool and slot table are touched once per station per checkArrivals()
+// and on feed updates, so they can live in PSRAM. With no room anywhere the
+// store stays empty and the map runs on the live window alone.
+void HorizonStore::begin() {
+  const size_t stations = StationMap::stations.size();
+  feedMask = new uint8_t[stations]();
+  pool = static_cast<uint16_t*>(MemoryPolicy::allocate(HORIZON_CAPACITY * sizeof(uint16_t), MemoryPolicy::External));
+  slots = static_cast<HorizonSlot*>(MemoryPolicy::allocate(stations * kMaxFeeds * sizeof(HorizonSlot), MemoryPolicy::External));
+  if (!pool || !slots || stations * kMaxFeeds > 65536) {
+    MemoryPolicy::release(pool);
+    MemoryPolicy::release(slots);
+    pool = nullptr;
+    slots = nullptr;
+  } else {
+    slotCount = stations * kMaxFeeds;
+    memset(slots, 0, slotCount * sizeof(HorizonSlot));
+    order = new uint16_t[slotCount];
+  }
+  capacity = pool ? HORIZON_CAPACITY : 0;
+  Serial.printf("Horizon store: %u entries (%u bytes) for %u stations x %u feeds\n",
+                static_cast<unsigned>(capacity),
+                static_cast<unsigned>(capacity * sizeof(uint16_t) + slotCount * sizeof(HorizonSlot)),
+                static_cast<unsigned>(stations), static_cast<unsigned>(kMaxFeeds));
+}
+
+bool HorizonStore::Batch::add(time_t arrival, uint8_t route) {
+  if (arrival < epoch || arrival - epoch > static_cast<time_t>(kMaxOffset) ||
+      count >= HORIZON_MAX_PER_STATION) {
+    droppedEntries++;
+    return false;
+  }
+  entries[count++] = static_cast<uint16_t>((arrival - epoch) << kRouteBits) | (route & ((1U << kRouteBits) - 1));
+  return true;
+}
+
+void HorizonStore::advance(time_t now) {
+  time_t target = now - kTrailSeconds;
+  if (epoch != 0 && target >= epoch && target - epoch <= kRebaseAfter) return;
+  rebase(target);
+}
+
+void HorizonStore::replace(size_t station, uint8_t feed, Batch& batch, time_t liveUntil) {
+  if (!pool || feed >= kMaxFeeds) {
+    droppedEntries += batch.count;
+    return;
+  }
+  HorizonSlot& slot = slots[station * kMaxFeeds + feed];
+  // Small and nearly sorted (two direction lists), so insertion sort.
+  for (uint8_t i = 1; i < batch.count; ++i) {
+    uint16_t v = batch.entries[i];
+    uint8_t j = i;
+    for (; j > 0 && batch.entries[j - 1] > v; --j) batch.entries[j] = batch.entries[j - 1];
+    batch.entries[j] = v;
+  }
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < batch.count; ++i) {
+    if (n == 0 || batch.entries[i] != batch.entries[n - 1]) batch.entries[n++] = batch.entries[i];
+  }
+
+  live -= slot.count;
+  slot.count = 0;
+  slot.cursor = 0;
+  if (n > slot.capacity) {
+    slot.capacity = 0;
+    if (end + n > capacity) compact();
+    if (end + n > capacity) {
+      droppedEntries += n - (capacity - end);
+      n = static_cast<uint8_t>(capacity - end);
+    }
+    slot.start = static_cast<uint16_t>(end);
+    slot.capacity = n;
+    end += n;
+  }
+
+  memcpy(&pool[slot.start], batch.entries, n * sizeof(uint16_t));
+  slot.count = n;
+  live += n;
+  while (slot.cursor < n && timeOf(pool[slot.start + slot.cursor]) <= liveUntil) slot.cursor++;
+  if (n) {
+    feedMask[station] |= 1U << feed;
+  } else {
+    feedMask[station] &= ~(1U << feed);
+  }
+}
+
+time_t HorizonStore::nextPending(size_t station) {
+  time_t next = 0;
+  for (uint8_t feeds = feedMask[station]; feeds; feeds &= feeds - 1) {
+    const HorizonSlot& run = slots[station * kMaxFeeds + __builtin_ctz(feeds)];
+    if (run.cursor == run.count) continue;
+    time_t arrival = timeOf(pool[run.start + run.cursor]);
+    if (next == 0 || arrival < next) next = arrival;
+  }
+  return next;
+}
+
+size_t HorizonStore::pendingCount(size_t station) {
+  size_t pending = 0;
+  for (uint8_t feeds = feedMask[station]; feeds; feeds &= feeds - 1) {
+    const HorizonSlot& run = slots[station * kMaxFeeds + __builtin_ctz(feeds)];
+    pending += run.count - run.cursor;
+  }
+  return pending;
+}
+
+uint32_t HorizonStore::routesAt(size_t station, time_t t, time_t window) {
+  if (t < epoch) return 0;
+  time_t from = t - window;
+  time_t fromOffset = from > epoch ? from - epoch : 0;
+  if (fromOffset > static_cast<time_t>(kMaxOffset)) return 0;
+  time_t toOffset = std::min(t - epoch, static_cast<time_t>(kMaxOffset));
+
+  uint32_t routes = 0;
+  for (uint8_t feeds = feedMask[station]; feeds; feeds &= feeds - 1) {
+    const HorizonSlot& run = slots[station * kMaxFeeds + __builtin_ctz(feeds)];
+    const uint16_t* first = &pool[run.start];
+    const uint16_t* last = first + run.count;
+    const uint16_t* it = std::lower_bound(first, last, static_cast<uint16_t>(fromOffset << kRouteBits));
+    for (; it != last && (*it >> kRouteBits) <= toOffset; ++it) {
+      routes |= 1UL << (*it & ((1U << kRouteBits) - 1));
+    }
+  }
+  return routes;
+}
+
+size_t HorizonStore::used() {
+  return live;
+}
+
+uint32_t HorizonStore::dropped() {
+  return droppedEntries;
+}
+
+// Moves the epoch to newEpoch, rewriting entries in place. Moving forward
+// drops entries older than the new epoch; a backwards clock step moves
+// entries up and drops those that no longer fit the offset bits, which are
+// beyond the horizon anyway. Only a gap longer than the offset range clears
+// the store.
+void HorizonStore::rebase(time_t newEpoch) {
+  const time_t delta = newEpoch - epoch;
+  const time_t maxOffset = static_cast<time_t>(kMaxOffset);
+  bool clear = epoch == 0 || delta > maxOffset || -delta > maxOffset;
+  epoch = newEpoch;
+  live = 0;
+  for (size_t i = 0; i < slotCount; ++i) {
+    HorizonSlot& slot = slots[i];
+    if (slot.count == 0) continue;
+    if (clear) {
+      slot.count = 0;
+      slot.cursor = 0;
+      feedMask[i / kMaxFeeds] &= ~(1U << (i % kMaxFeeds));
+      continue;
+    }
+    uint16_t* run = &pool[slot.start];
+    if (delta >= 0) {
+      uint16_t shift = static_cast<uint16_t>(delta << kRouteBits);
+      uint8_t expired = 0;
+      while (expired < slot.count && run[expired] < shift) expired++;
+      for (uint8_t i = expired; i < slot.count; ++i) run[i - expired] = run[i] - shift;
+      slot.count -= expired;
+      slot.cursor = slot.cursor > expired ? slot.cursor - expired : 0;
+    } else {
+      uint8_t keep = slot.count;
+      while (keep > 0 && (run[keep - 1] >> kRouteBits) > maxOffset + delta) keep--;
+      droppedEntries += slot.count - keep;
+      uint16_t shift = static_cast<uint16_t>(-delta << kRouteBits);
+      for (uint8_t i = 0; i < keep; ++i) run[i] += shift;
+      slot.count = keep;
+      if (slot.cursor > keep) slot.cursor = keep;
+    }
+    if (slot.count == 0) feedMask[i / kMaxFeeds] &= ~(1U << (i % kMaxFeeds));
+    live += slot.count;
+  }
+}
+
+// Packs every run to the front of the pool in pool order, so each move is
+// down or in place. Runs are trimmed to their current size.
+void HorizonStore::compact() {
+  if (!order) return;
+  size_t count = 0;
+  for (size_t i = 0; i < slotCount; ++i) {
+    if (slots[i].capacity) order[count++] = static_cast<uint16_t>(i);
+  }
+  std::sort(order, order + count, [](uint16_t a, uint16_t b) { return slots[a].start < slots[b].start; });
+
+  size_t write = 0;
+  for (size_t i = 0; i < count; ++i) {
+    HorizonSlot& slot = slots[order[i]];
+    memmove(&pool[write], &pool[slot.start], slot.count * sizeof(uint16_t));
+    slot.start = static_cast<uint16_t>(write);
+    slot.capacity = slot.count;
+    write += slot.count;
+  }
+  end = write;
+}
@@ -1,16 +1,96 @@
 #include "LEDManager.h"
+#include "FrameCompositor.h"
+#include "LedKernels.h"
+#include "Metrics.h"
+#include "LatencyTracer.h"
+
+#if LED_ASYNC_SHOW
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+namespace {
+TaskHandle_t showTaskHandle = nullptr;
+SemaphoreHandle_t transferDone = nullptr;  // given while the strip is idle
+volatile uint32_t lastTransferUs = 0;
+bool transferPending = false;              // a transfer was started and not yet accounted
+}
+#endif
 
 CRGB LEDManager::leds[NUM_LEDS_SUBWAY];
 CRGB LEDManager::errorLeds[NUM_LEDS_ERROR];
+CRGB LEDManager::shownLeds[NUM_LEDS_SUBWAY];
+CRGB LEDManager::shownErrorLeds[NUM_LEDS_ERROR];
+bool LEDManager::hasShown = false;
 
 void LEDManager::initializeLEDs() {
+#if LED_ASYNC_SHOW
+    FastLED.addLeds<LED_TYPE, DATA_PIN_SUBWAY, COLOR_ORDER>(shownLeds, NUM_LEDS_SUBWAY);
+    FastLED.addLeds<LED_TYPE, DATA_PIN_ERROR, COLOR_ORDER>(shownErrorLeds, NUM_LEDS_ERROR);
+    // FastLED.show() busy-waits to honour the chipset's maximum refresh
+    // rate; frames are already paced by the transfer itself.
+    FastLED.setMaxRefreshRate(0);
+    transferDone = xSemaphoreCreateBinary();
+    xSemaphoreGive(transferDone);
+    xTaskCreatePinnedToCore(showTask, "ledshow", 4096, nullptr, LED_SHOW_PRIORITY, &showTaskHandle, LED_SHOW_CORE);
+#else
     FastLED.addLeds<LED_TYPE, DATA_PIN_SUBWAY, COLOR_ORDER>(leds, NUM_LEDS_SUBWAY);
+    FastLED.addLeds<LED_TYPE, DATA_PIN_ERROR, COLOR_ORDER>(errorLeds, NUM_LEDS_ERROR);
+#endif
     FastLED.setBrightness(5);
+    FrameCompositor::initialize();
 }
 
+// Composes the layers into the strip buffer and pushes it only when the
+// frame differs from the last one sent, so an idle map doesn't spend ~15 ms
+// per loop clocking out identical pixels.
 void LEDManager::show() {
+    FrameCompositor::compose(leds, NUM_LEDS_SUBWAY);
+    if (hasShown &&
+        memcmp(shownLeds, leds, sizeof(leds)) == 0 &&
+        memcmp(shownErrorLeds, errorLeds, sizeof(errorLeds)) == 0) {
+        LatencyTracer::shown();
+        return;
+    }
+    unsigned long start = micros();
+    present();
+    Metrics::showTime.record(micros() - start);
+    hasShown = true;
+    LatencyTracer::shown();
+}
+
+#if LED_ASYNC_SHOW
+// Hands the composed frame to the show task. Only waits if the previous
+// transfer is still clocking out; otherwise this is a 1.5 KB copy.
+void LEDManager::present() {
+    xSemaphoreTake(transferDone, portMAX_DELAY);
+    // The previous frame's transfer: it is only known once that frame is
+    // done, so each sample is recorded one presented frame late.
+    if (transferPending) Metrics::showTransferTime.record(lastTransferUs);
+    memcpy(shownLeds, leds, sizeof(leds));
+    memcpy(shownErrorLeds, errorLeds, sizeof(errorLeds));
+    transferPending = true;
+    xTaskNotifyGive(showTaskHandle);
+}
+
+void LEDManager::showTask(void* arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        unsigned long start = micros();
+        FastLED.show();
+        lastTransferUs = micros() - start;
+        xSemaphoreGive(transferDone);
+    }
+}
+#else
+void LEDManager::present() {
+    unsigned long start = micros();
     FastLED.show();
+    Metrics::showTransferTime.record(micros() - start);
+    memcpy(shownLeds, leds, sizeof(leds));
+    memcpy(shownErrorLeds, errorLeds, sizeof(errorLeds));
 }
+#endif
 
 void LEDManager::awaitingDataSequence() {
     // Alternate every other LED on/off, then swap every second
@@ -20,8 +100,25 @@ void LEDManager::awaitingDataSequence() {
 
     CRGB warmWhite = CRGB(255, 180, 80); // Warm white color
 
-    for (int i = 0; i < NUM_LEDS_SUBWAY; ++i) {
-        bool is_even = (i % 2 == 0);
-        leds[i] = (is_even == even_on) ? warmWhite : CRGB::Black;
+    CRGB* status = FrameCompositor::status;
+    LedKernels::fill(reinterpret_cast<uint8_t*>(status), NUM_LEDS_SUBWAY, 0, 0, 0);
+    for (int i = even_on ? 0 : 1; i < NUM_LEDS_SUBWAY; i += 2) {
+        status[i] = warmWhite;
     }
-}
\ No newline at end of file
+    FrameCompositor::setEnabled(FrameCompositor::Status, true);
+}
+
+void LEDManager::clearAwaitingSequence() {
+    FrameCompositor::setEnabled(FrameCompositor::Status, false);
+}
+
+unsigned long LEDManager::msUntilNextAwaitingStep() {
+    const uint32_t step = 1000; // half of awaitingDataSequence's period
+    return step - (millis() % step);
+}
+
+// Error strip: LED 0 shows WiFi, LED 1 the feed connection. Dark when healthy.
+void LEDManager::setConnectionStatus(bool wifiConnected, bool websocketConnected) {
+    errorLeds[0] = wifiConnected ? CRGB::Black : CRGB::Red;
+    errorLeds[1] = websocketConnected ? CRGB::Black : CRGB::Orange;
+}
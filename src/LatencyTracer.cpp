@@ -0,0 +1,121 @@
+#include "LatencyTracer.h"
+#include <Arduino.h>
+#include <sys/time.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+// Anything earlier means SNTP has not set the clock yet.
+constexpr time_t kClockValidAfter = 1600000000;
+
+const char* const kStageNames[LatencyTracer::StageCount] = {
+  "feed", "network", "parse", "render", "total"
+};
+
+uint32_t clampUs(int64_t us) {
+  return us > static_cast<int64_t>(UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(us);
+}
+}
+
+LatencyTracer::Trace LatencyTracer::trace = {};
+LatencyHistogram LatencyTracer::histograms[StageCount];
+uint32_t LatencyTracer::lastId = 0;
+uint32_t LatencyTracer::missed = 0;
+uint32_t LatencyTracer::skewed = 0;
+
+// A message that arrives before the previous one was shown replaces its
+// trace; the frame that follows covers both.
+void LatencyTracer::received() {
+  trace = {};
+  trace.active = true;
+  trace.receivedUs = micros();
+  trace.receivedMs = wallClockMs();
+}
+
+// Must run before deserializing: zero-copy parsing rewrites the buffer.
+void LatencyTracer::readHeader(const char* header, size_t length) {
+  if (!trace.active) return;
+  trace.msgId = static_cast<uint32_t>(headerNumber(header, length, "\"msg_id\":"));
+  trace.feedMs = headerNumber(header, length, "\"feed_ms\":");
+  trace.sentMs = headerNumber(header, length, "\"sent_ms\":");
+
+  if (trace.msgId) {
+    // IDs restart with the server, so only count forward gaps.
+    if (lastId && trace.msgId > lastId + 1) missed += trace.msgId - lastId - 1;
+    lastId = trace.msgId;
+  }
+  if (trace.feedMs && trace.sentMs) recordWall(Feed, trace.feedMs, trace.sentMs);
+  if (trace.sentMs && trace.receivedMs) recordWall(Network, trace.sentMs, trace.receivedMs);
+}
+
+void LatencyTracer::parsed() {
+  if (!trace.active) return;
+  trace.parsedUs = micros();
+  trace.parsed = true;
+  histograms[Parse].record(trace.parsedUs - trace.receivedUs);
+}
+
+// Called after every show(), including ones skipped as unchanged: the
+// frame on the strip is current either way.
+void LatencyTracer::shown() {
+  if (!trace.active || !trace.parsed) return;
+  uint32_t now = micros();
+  histograms[Render].record(now - trace.parsedUs);
+  int64_t origin = trace.feedMs ? trace.feedMs : trace.sentMs;
+  if (origin && trace.receivedMs) {
+    recordWall(Total, origin, trace.receivedMs + (now - trace.receivedUs) / 1000);
+  }
+  trace.active = false;
+}
+
+const LatencyHistogram& LatencyTracer::histogram(Stage stage) {
+  return histograms[stage < StageCount ? stage : Total];
+}
+
+const char* LatencyTracer::stageName(Stage stage) {
+  return stage < StageCount ? kStageNames[stage] : "?";
+}
+
+uint32_t LatencyTracer::lastMessageId() {
+  return lastId;
+}
+
+uint32_t LatencyTracer::missedMessages() {
+  return missed;
+}
+
+uint32_t LatencyTracer::clockSkewSamples() {
+  return skewed;
+}
+
+int64_t LatencyTracer::serverTimeMs() {
+  return trace.active ? trace.sentMs : 0;
+}
+
+uint32_t LatencyTracer::receivedAtUs() {
+  return trace.receivedUs;
+}
+
+int64_t LatencyTracer::wallClockMs() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (tv.tv_sec < kClockValidAfter) return 0;
+  return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+// Reads an integer field from the bytes ahead of "data". Returns 0 if absent.
+int64_t LatencyTracer::headerNumber(const char* header, size_t length, const char* key) {
+  const char* found = static_cast<const char*>(memmem(header, length, key, strlen(key)));
+  if (!found) return 0;
+  return strtoll(found + strlen(key), nullptr, 10);
+}
+
+// Stages measured across two clocks can come out negative when the server
+// and device disagree; those are counted rather than recorded.
+void LatencyTracer::recordWall(Stage stage, int64_t fromMs, int64_t toMs) {
+  if (toMs < fromMs) {
+    skewed++;
+    return;
+  }
+  histograms[stage].record(clampUs((toMs - fromMs) * 1000));
+}
@@ -1,82 +1,202 @@
 #include "MTAManager.h"
-#include "GeneratedStationMap.h"
+#include "StationMap.h"
 #include <ArduinoJson.h>
-#include "LEDManager.h"
-#include <set>
+#include "FrameCompositor.h"
 #include "SubwayColors.h"
-#include <ArduinoWebsockets.h>
 #include "Station.h"
+#include "Metrics.h"
+#include "ArrivalHistory.h"
+#include "DisplayMode.h"
+#include "FlightRecorder.h"
+#include "LatencyTracer.h"
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <limits>
+#include "ContentHash.h"
+#include "ServiceFrequency.h"
+#include "TimeManager.h"
+#include "TimeScrub.h"
+#include <sys/time.h>
 
 SubwayColorMap MtaManager::colorMap;
 
-void MtaManager::parseData(websockets::WebsocketsMessage msg) {
-  doc.clear();
-  DeserializationError error = deserializeJson(doc, msg.data());
+void MtaManager::begin() {
+  merged.reserve(2 * HORIZON_MAX_PER_STATION);
+  for (Station& station : StationMap::stations) station.trains.reserve(MTA_TRAINS_PER_STATION);
+  doc = new ParseDocument(MTA_JSON_DOC_BYTES);
+  if (doc->capacity() == 0) {
+    Serial.println("Parse document allocation failed");
+  }
+}
+
+void MtaManager::parseData(char* payload, size_t length) {
+  if (!doc) return;
+  unsigned long start = micros();
+
+  // Trace fields ahead of "data" change with every broadcast, so they are
+  // read here and left out of the unchanged-payload hash. sent_ms also
+  // keeps the clock in step with the server, so read it before taking now.
+  const char* data = static_cast<const char*>(memmem(payload, length, "\"data\"", 6));
+  size_t headerLength = data ? data - payload : 0;
+  LatencyTracer::readHeader(payload, headerLength);
+  TimeManager::onServerTime(LatencyTracer::serverTimeMs(), LatencyTracer::receivedAtUs());
+  time_t now;
+  time(&now);
+
+  // The server rebroadcasts unchanged state; skip byte-identical payloads
+  // until a train they contain would pass the look-ahead check.
+  size_t bodyLength = length - headerLength;
+  uint32_t payloadHash = ContentHash::hash(payload + headerLength, bodyLength);
+  if (payloadHash == lastPayloadHash && bodyLength == lastPayloadLength && now < payloadExpires) {
+    Metrics::messagesSkipped++;
+    LatencyTracer::parsed();
+    return;
+  }
+
+  doc->clear();
+  // Mutable input puts ArduinoJson in zero-copy mode: strings are terminated
+  // in place and referenced from the payload rather than duplicated into doc.
+  DeserializationError error = deserializeJson(*doc, payload, length);
   if (error) {
+    Metrics::parseErrors++;
+    FlightRecorder::log(FlightRecorder::ParseError, error.code(), length);
     Serial.print("deserializeJson() failed: ");
     Serial.println(error.c_str());
     return;
   }
 
-  JsonArray stations = doc["data"].as<JsonArray>();
-  time_t now;
-  time(&now);
-
+  // Feed and generation may be set for the whole message and overridden per
+  // station record. Generation 0 (absent) is always applied.
+  JsonArray stations = (*doc)["data"].as<JsonArray>();
+  const int feed = (*doc)["feed"] | 0;
+  const uint32_t generation = (*doc)["gen"] | 0u;
+  HorizonStore::advance(now);
+  time_t expires = std::numeric_limits<time_t>::max();
+  uint32_t updatedBefore = Metrics::stationsUpdated;
   for (JsonObject stationObj : stations) {
-    handleStationUpdate(stationObj, now);
+    expires = std::min(expires, handleStationUpdate(stationObj, now, feed, generation));
   }
+  lastPayloadHash = payloadHash;
+  lastPayloadLength = bodyLength;
+  payloadExpires = expires;
+  refreshPending = true;
+  uint32_t elapsed = micros() - start;
+  Metrics::parseTime.record(elapsed);
+  LatencyTracer::parsed();
+  FlightRecorder::log(FlightRecorder::Parse, Metrics::stationsUpdated - updatedBefore, elapsed);
 }
 
 void MtaManager::checkArrivals() {
-#ifdef DEBUG
-  static std::map<int, std::set<std::string>> trainsAtStationLast;
-#endif  
   time_t currentTime;
   time(&currentTime);
+  refreshPending = false;
+  nextChangeTime = 0;
+  ServiceFrequency::advance(currentTime);
+  HorizonStore::advance(currentTime);
+
+  for (size_t i = 0; i < StationMap::stations.size(); ++i) {
+    Station &station = StationMap::stations[i];
+    station.presentRoutes = 0;
 
-  for (auto &pair : stationMap) {
-    LEDManager::leds[pair.first] = CRGB::Black;
-    Station &station = pair.second;
-    std::set<std::string> trainsNow;
+    // Stored predictions that have come within the look-ahead, whether or
+    // not the feed is still up.
+    // replace() starts the cursor past the trains the record added directly,
+    // so these are never already in the list. Inserted in order, since other
+    // feeds' trains may already sit later in it.
+    HorizonStore::promote(i, currentTime + kLookAheadSeconds, [&station](uint8_t route, time_t arrival, uint8_t feed) {
+      Train promoted(route, arrival, feed, Train::Promoted);
+      station.trains.insert(std::upper_bound(station.trains.begin(), station.trains.end(), promoted, Train::earlier),
+                            promoted);
+      Metrics::trainsPromoted++;
+    });
+    time_t pending = HorizonStore::nextPending(i);
+    if (pending) {
+      time_t promoteAt = pending - kLookAheadSeconds;
+      if (nextChangeTime == 0 || promoteAt < nextChangeTime) nextChangeTime = promoteAt;
+    }
 
     for (Train &train : station.trains) {
-      if (train.atStation(currentTime)) {
-        LEDManager::leds[pair.first] = colorMap.getColor(train.routeId);
-        trainsNow.insert(train.routeId);
+      time_t change = train.arrivalTime > currentTime ? train.arrivalTime : train.departureTime();
+      if (change > currentTime && (nextChangeTime == 0 || change < nextChangeTime)) {
+        nextChangeTime = change;
+      }
 
+      if (train.atStation(currentTime)) {
+        station.presentRoutes |= 1UL << train.route;
+        if (!train.arrived) {
+          train.arrived = true;
+          ArrivalHistory::record(train.arrivalTime, i, train.route);
+          ServiceFrequency::record(station.frequency);
 #ifdef DEBUG
-        if (trainsAtStationLast[pair.first].count(train.routeId) == 0) {
           Serial.printf(
             "Train %s ENTERED station %s (ID: %s) at %s",
-            train.routeId.c_str(),
-            station.name.c_str(),
-            station.id.c_str(),
+            SubwayColorMap::routeName(train.route),
+            station.name,
+            station.id,
             ctime(&train.arrivalTime)
           );
-        }
 #endif
+        }
       }
     }
-#ifdef DEBUG
-    trainsAtStationLast[pair.first] = trainsNow;
-#endif
   }
+  renderArrivals();
 }
 
-Station* MtaManager::findStationById(const std::string& id) {
-    for (auto& pair : stationMap) {
-        if (pair.second.id == id) {
-            return &pair.second;
-        }
+// Draws the arrivals layer from the per-station route bitsets and the
+// current display mode. Stations off the filter drop out of the base map.
+// Each station's colour fans out to every LED it is drawn at. The heatmap
+// view colours by the station's windowed arrival count instead.
+void MtaManager::renderArrivals() {
+  const uint32_t filter = DisplayMode::filterMask();
+  const uint32_t step = DisplayMode::cycleStep();
+  // A preview shows arrivals at the scrubbed time whatever the view.
+  const time_t previewAt = TimeScrub::previewTime();
+  const bool heatmap = !previewAt && DisplayMode::view() == DisplayMode::Heatmap;
+  if (heatmap) ServiceFrequency::advance(time(nullptr));
+  for (size_t i = 0; i < StationMap::stations.size(); ++i) {
+    const Station &station = StationMap::stations[i];
+    bool onFilter = filter == DisplayMode::kAllRoutes || (station.routeMask & filter);
+    CRGB color = CRGB::Black;
+    if (heatmap) {
+      uint8_t level = ServiceFrequency::level(station.frequency);
+      if (onFilter && level) color = CRGB(ServiceFrequency::color(level));
+    } else {
+      uint32_t present = previewAt ? routesAt(station, previewAt) : station.presentRoutes;
+      uint32_t visible = present & filter;
+      if (visible) color = CRGB(colorMap.colorForCode(DisplayMode::pickRoute(visible, step)));
+    }
+    CRGB base = onFilter ? CRGB(255, 255, 255) : CRGB(CRGB::Black);
+    for (const uint16_t* led = StationMap::ledsBegin(i); led != StationMap::ledsEnd(i); ++led) {
+      FrameCompositor::arrivals[*led] = color;
+      FrameCompositor::base[*led] = base;
     }
-    return nullptr;
+  }
+  DisplayMode::markRendered(step);
+  TimeScrub::markRendered(previewAt);
+}
+
+// Routes in their arrival window at t, from the horizon store's sorted runs.
+// A station the store holds nothing for (no pool, or it was full) falls back
+// to scanning its live list, which covers the look-ahead.
+uint32_t MtaManager::routesAt(const Station& station, time_t t) {
+  const size_t index = StationMap::indexOf(station);
+  if (HorizonStore::holds(index)) {
+    return HorizonStore::routesAt(index, t, Train::arrivalWindowSeconds);
+  }
+  uint32_t routes = 0;
+  for (const Train& train : station.trains) {
+    if (train.atStation(t)) routes |= 1UL << train.route;
+  }
+  return routes;
 }
 
 void MtaManager::purgeExpiredTrains() {
   time_t now;
   time(&now);
-  for (auto &pair : stationMap) {
-    Station &station = pair.second;
+  for (Station &station : StationMap::stations) {
+    size_t before = station.trains.size();
     station.trains.erase(
       std::remove_if(
         station.trains.begin(),
@@ -85,56 +205,247 @@ void MtaManager::purgeExpiredTrains() {
       ),
       station.trains.end()
     );
+    Metrics::trainsPurged += before - station.trains.size();
   }
 }
 
-void MtaManager::addNewTrains(Station& station, JsonArray arr) {
-  for (JsonObject train : arr) {
-    Train t;
-    t.routeId = train["route"].as<std::string>();
-    struct tm tm;
-    strptime(train["time"].as<const char*>(), "%Y-%m-%dT%H:%M:%S%z", &tm);
-    t.arrivalTime = mktime(&tm);
+namespace {
+// Decoded arrivals sort by time, route, then direction, so a train listed in
+// both directions ends up adjacent.
+bool laterThan(const MtaManager::StationUpdate::Arrival& a, const MtaManager::StationUpdate::Arrival& b) {
+  if (a.time != b.time) return a.time > b.time;
+  if (a.route != b.route) return a.route > b.route;
+  return a.direction > b.direction;
+}
 
-    // Reject trains more than 30s old or over 5 minutes ahead.
-    time_t now;
-    time(&now);
-    double timeDiff = difftime(t.arrivalTime, now);
-    if (timeDiff > 300 || timeDiff < -30.1) {
-#ifdef DEBUG
-      Serial.printf("Skipping train station=%s route=%s diff=%.1fs arrival=%ld now=%ld\n",
-                    station.id.c_str(), t.routeId.c_str(), timeDiff,
-                    static_cast<long>(t.arrivalTime), static_cast<long>(now));
-#endif
+// Negative if the existing train comes first, 0 if it is the same train.
+int compareTrain(const Train& t, const MtaManager::StationUpdate::Arrival& a) {
+  if (t.arrivalTime != a.time) return t.arrivalTime < a.time ? -1 : 1;
+  return static_cast<int>(t.route) - static_cast<int>(a.route);
+}
+
+// Whether the update takes over this train: same feed, and either a
+// direction the update lists or promoted from that feed's horizon.
+bool supersedes(const MtaManager::StationUpdate& update, const Train& t) {
+  return t.feed == update.feed &&
+         (t.direction == Train::Promoted || (update.directions & (1U << t.direction)));
+}
+
+// Index of the update arrival that reschedules an arrived train: same route
+// and direction, within the arrival window of it but at another time (at the
+// same time it is the same train and merges in place). -1 if none.
+int rescheduled(const MtaManager::StationUpdate& update, const Train& t) {
+  for (uint8_t k = 0; k < update.count; ++k) {
+    const MtaManager::StationUpdate::Arrival& a = update.arrivals[k];
+    if (a.route != t.route || a.time == t.arrivalTime) continue;
+    if (t.direction != Train::Promoted && a.direction != t.direction) continue;
+    time_t moved = a.time > t.arrivalTime ? a.time - t.arrivalTime : t.arrivalTime - a.time;
+    if (moved <= Train::arrivalWindowSeconds) return k;
+  }
+  return -1;
+}
+
+// Decodes one direction list of a JSON station record.
+void decodeArrivals(JsonObject stationObj, const char* key, Train::Direction direction,
+                    MtaManager::StationUpdate& update) {
+  if (!stationObj.containsKey(key)) return;
+  update.directions |= 1U << direction;
+  for (JsonObject train : stationObj[key].as<JsonArray>()) {
+    time_t arrival;
+    if (!TimeManager::parseFeedTime(train["time"].as<const char*>(), &arrival) ||
+        !update.add(direction, SubwayColorMap::routeCode(train["route"].as<const char*>()), arrival)) {
+      Metrics::trainsOutOfWindow++;
+    }
+  }
+}
+}
+
+// Single entry point for arrivals, whatever format they were decoded from.
+// Sorts the update once, then merges it against the station's time-ordered
+// train list in one linear pass that also:
+//   - drops expired trains,
+//   - drops the previous generation's pending trains for the update's feed
+//     and directions, so a rescheduled prediction moves instead of leaving a
+//     phantom behind,
+//   - keeps trains the update lists again in place, with their arrived flag,
+//   - carries the arrived flag to a train the update moves by no more than
+//     the arrival window, dropping the old entry, so it isn't recorded twice,
+//   - filters the update to the window: within the look-ahead into the live
+//     list, within the horizon into the (already sorted) horizon batch.
+// O(n + m) per station with no dedupe scan. Returns false if the update is
+// from a stale generation or unknown feed. admitAt is set to the earliest
+// time a train rejected as beyond the horizon would be accepted, or 0.
+bool MtaManager::applyStationUpdate(Station& station, StationUpdate& update, time_t now, time_t* admitAt) {
+  *admitAt = 0;
+  if (update.feed >= MTA_MAX_FEEDS || isStale(update.feed, update.generation)) {
+    Metrics::stationsRejected++;
+    return false;
+  }
+  Metrics::stationsUpdated++;
+
+  // Insertion sort: the update is two runs, each nearly sorted already.
+  StationUpdate::Arrival* in = update.arrivals;
+  for (uint8_t i = 1; i < update.count; ++i) {
+    StationUpdate::Arrival a = in[i];
+    uint8_t j = i;
+    for (; j > 0 && laterThan(in[j - 1], a); --j) in[j] = in[j - 1];
+    in[j] = a;
+  }
+
+  // Trains arriving before this have left their window.
+  const time_t expiredBefore = now - Train::arrivalWindowSeconds;
+  const std::vector<Train>& existing = station.trains;
+  for (const Train& t : existing) {
+    if (!t.arrived || t.arrivalTime < expiredBefore || !supersedes(update, t)) continue;
+    int k = rescheduled(update, t);
+    if (k >= 0) in[k].arrived = true;
+  }
+  HorizonStore::Batch horizon;
+  merged.clear();
+  size_t i = 0;
+  uint8_t j = 0;
+  while (i < existing.size() || j < update.count) {
+    const Train* e = i < existing.size() ? &existing[i] : nullptr;
+    int order = !e ? 1 : j == update.count ? -1 : compareTrain(*e, in[j]);
+
+    if (order < 0 || (order == 0 && !supersedes(update, *e))) {
+      i++;
+      if (e->arrivalTime < expiredBefore) {
+        Metrics::trainsPurged++;
+      } else if (supersedes(update, *e) && (!e->arrived || rescheduled(update, *e) >= 0)) {
+        Metrics::trainsReplaced++;
+      } else {
+        merged.push_back(*e);
+      }
       continue;
     }
 
+    const StationUpdate::Arrival& a = in[j++];
+    if (j > 1 && in[j - 2].time == a.time && in[j - 2].route == a.route) continue;  // listed twice
+    const bool same = order == 0;  // e is this train from an earlier generation
+    if (same) i++;
+    station.routeMask |= 1UL << a.route;
 
-    bool exists = false;
-    for (const auto& existing : station.trains) {
-      if (existing.routeId == t.routeId && existing.arrivalTime == t.arrivalTime) {
-        exists = true;
-        break;
+    if (a.time < expiredBefore || a.time - now > HORIZON_SECONDS) {
+      Metrics::trainsOutOfWindow++;
+      if (same) Metrics::trainsPurged++;
+      if (a.time - now > HORIZON_SECONDS && (*admitAt == 0 || a.time - HORIZON_SECONDS < *admitAt)) {
+        *admitAt = a.time - HORIZON_SECONDS;
       }
+#ifdef DEBUG
+      Serial.printf("Skipping train station=%s route=%s diff=%lds arrival=%ld now=%ld\n",
+                    station.id, SubwayColorMap::routeName(a.route), static_cast<long>(a.time - now),
+                    static_cast<long>(a.time), static_cast<long>(now));
+#endif
+      continue;
     }
-    if (!exists) {
-      station.trains.push_back(t);
+    horizon.add(a.time, a.route);
+    if (a.time - now > kLookAheadSeconds) continue;
+
+    if (same) {
+      Train kept = *e;
+      kept.direction = a.direction;
+      kept.arrived = kept.arrived || a.arrived;
+      merged.push_back(kept);
+    } else {
+      merged.emplace_back(a.route, a.time, update.feed, static_cast<Train::Direction>(a.direction));
+      merged.back().arrived = a.arrived;
+      Metrics::trainsAdded++;
     }
   }
+
+  // Only this feed's run: other feeds' stored predictions stay queued.
+  const size_t index = StationMap::indexOf(station);
+  HorizonStore::replace(index, update.feed, horizon, now + kLookAheadSeconds);
+
+  // Room for every train promote() can add too, so checkArrivals() never
+  // grows the list. begin() reserved MTA_TRAINS_PER_STATION; past that the
+  // capacity doubles, so a busy station stops reallocating after a few steps
+  // rather than at every new high.
+  const size_t needed = merged.size() + HorizonStore::pendingCount(index);
+  if (needed > station.trains.capacity()) {
+    station.trains.reserve(std::max(needed, 2 * station.trains.capacity()));
+  }
+  station.trains.assign(merged.begin(), merged.end());
+  return true;
+}
+
+// A generation older than the newest one applied for its feed is a late
+// duplicate or reordered message; applying it would bring back predictions
+// the newer one replaced.
+bool MtaManager::isStale(uint8_t feed, uint32_t generation) {
+  if (generation == 0) return false;
+  const uint8_t bit = 1U << feed;
+  if (feedsSeen & bit) {
+    int32_t age = static_cast<int32_t>(feedGeneration[feed] - generation);
+    if (age > 0) return true;
+    if (age == 0) return false;
+  }
+  feedGeneration[feed] = generation;
+  feedsSeen |= bit;
+  return false;
+}
+
+void MtaManager::resetGenerations() {
+  feedsSeen = 0;
+}
+
+// Decodes one JSON station record and applies it, unless it matches the last
+// record applied to that station. Returns the time until which an identical
+// record may be skipped.
+time_t MtaManager::handleStationUpdate(JsonObject stationObj, time_t now, int feed, uint32_t generation) {
+  const time_t never = std::numeric_limits<time_t>::max();
+  const char* jsonId = stationObj["id"].as<const char*>();
+  if (!jsonId) return never;
+  Station* station = StationMap::find(jsonId);
+  if (!station) return never;
+
+  feed = stationObj["feed"] | feed;
+  if (feed < 0 || feed >= MTA_MAX_FEEDS) {
+    Metrics::stationsRejected++;
+    return never;
+  }
+
+  uint32_t digest = stationDigest(stationObj, static_cast<uint8_t>(feed));
+  if (digest == station->feedDigest && now < station->digestExpires) {
+    Metrics::stationsSkipped++;
+    return station->digestExpires;
+  }
+
+  StationUpdate update;
+  update.feed = static_cast<uint8_t>(feed);
+  update.generation = stationObj["gen"] | generation;
+  decodeArrivals(stationObj, "N", Train::North, update);
+  decodeArrivals(stationObj, "S", Train::South, update);
+  time_t admitAt;
+  if (!applyStationUpdate(*station, update, now, &admitAt)) return never;
+
+  station->feedDigest = digest;
+  station->digestExpires = admitAt ? admitAt : never;
+  return station->digestExpires;
 }
 
-void MtaManager::handleStationUpdate(JsonObject stationObj, time_t now) {
-  std::string jsonId = stationObj["id"].as<std::string>();
-  Station* station = findStationById(jsonId);
-  if (station) {
-    if (stationObj.containsKey("N")) addNewTrains(*station, stationObj["N"].as<JsonArray>());
-    if (stationObj.containsKey("S")) addNewTrains(*station, stationObj["S"].as<JsonArray>());
+// Hashes the resolved feed, which directions are present and the route/time
+// strings of both. A missing key leaves that direction alone while an empty
+// one clears it, and each feed replaces only its own trains, so records that
+// differ in either must not match. With zero-copy parsing the strings point
+// into the payload, so this is far cheaper than the strptime, window check
+// and dedupe scan it lets us skip.
+uint32_t MtaManager::stationDigest(JsonObject stationObj, uint8_t feed) {
+  uint32_t h = ContentHash::hash(&feed, sizeof(feed));
+  for (const char* direction : {"N", "S"}) {
+    const uint8_t present = stationObj.containsKey(direction);
+    h = ContentHash::hash(&present, sizeof(present), ContentHash::hashString(direction, h));
+    for (JsonObject train : stationObj[direction].as<JsonArray>()) {
+      h = ContentHash::hashString(train["route"].as<const char*>(), h);
+      h = ContentHash::hashString(train["time"].as<const char*>(), h);
+    }
   }
+  return h;
 }
 
 bool MtaManager::isAnyTrainPresent() {
-  for (const auto& pair : stationMap) {
-    const Station& station = pair.second;
+  for (const Station& station : StationMap::stations) {
     if (!station.trains.empty()) {
       return true;
     }
@@ -142,9 +453,27 @@ bool MtaManager::isAnyTrainPresent() {
   return false;
 }
 
+// True when new data arrived or a train entered/left its window since the
+// last checkArrivals(); otherwise the LED buffer is already current.
+bool MtaManager::isRefreshDue() {
+  if (refreshPending) return true;
+  if (nextChangeTime == 0) return false;
+  time_t now;
+  time(&now);
+  return now >= nextChangeTime;
+}
+
+unsigned long MtaManager::msUntilNextChange() {
+  if (refreshPending) return 0;
+  if (nextChangeTime == 0) return ULONG_MAX;
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (tv.tv_sec >= nextChangeTime) return 0;
+  return static_cast<unsigned long>(nextChangeTime - tv.tv_sec) * 1000UL - tv.tv_usec / 1000;
+}
+
 bool MtaManager::hasAnyTrainData() {
-  for (const auto& pair : stationMap) {
-    const Station& station = pair.second;
+  for (const Station& station : StationMap::stations) {
     if (!station.trains.empty()) {
       return true;
     }
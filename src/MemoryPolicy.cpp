@@ -0,0 +1,153 @@
+#include "MemoryPolicy.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#endif
+
+uint32_t MemoryPolicy::fallbackCount = 0;
+
+namespace {
+const char* const kTierNames[MemoryPolicy::TierCount] = {"internal", "external"};
+
+#ifdef ARDUINO
+uint32_t capsFor(MemoryPolicy::Tier tier) {
+  return tier == MemoryPolicy::External ? MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT
+                                        : MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+}
+#else
+// Each simulated block carries its size and tier ahead of the payload.
+struct alignas(std::max_align_t) BlockHeader {
+  size_t size;
+  MemoryPolicy::Tier tier;
+};
+
+size_t budget[MemoryPolicy::TierCount] = {320 * 1024, 8 * 1024 * 1024};
+size_t used[MemoryPolicy::TierCount] = {};
+
+BlockHeader* headerOf(const void* ptr) {
+  return reinterpret_cast<BlockHeader*>(const_cast<char*>(static_cast<const char*>(ptr)) - sizeof(BlockHeader));
+}
+
+void* simulatedAlloc(size_t bytes, MemoryPolicy::Tier tier) {
+  if (used[tier] > budget[tier] || bytes > budget[tier] - used[tier]) return nullptr;
+  BlockHeader* block = static_cast<BlockHeader*>(malloc(sizeof(BlockHeader) + bytes));
+  if (!block) return nullptr;
+  block->size = bytes;
+  block->tier = tier;
+  used[tier] += bytes;
+  return block + 1;
+}
+#endif
+}
+
+void MemoryPolicy::begin() {
+#ifdef ARDUINO
+  if (hasExternal()) heap_caps_malloc_extmem_enable(PSRAM_MALLOC_THRESHOLD);
+  Serial.printf("Memory: internal %u KB free, PSRAM %u KB free\n",
+                static_cast<unsigned>(freeBytes(Internal) / 1024),
+                static_cast<unsigned>(freeBytes(External) / 1024));
+#endif
+}
+
+bool MemoryPolicy::hasExternal() {
+#ifdef ARDUINO
+  return psramFound();
+#else
+  return budget[External] > 0;
+#endif
+}
+
+void* MemoryPolicy::allocate(size_t bytes, Tier tier) {
+  void* ptr = nullptr;
+#ifdef ARDUINO
+  if (tier == Internal || hasExternal()) ptr = heap_caps_malloc(bytes, capsFor(tier));
+  if (!ptr && tier == External) {
+    ptr = heap_caps_malloc(bytes, capsFor(Internal));
+    if (ptr) fallbackCount++;
+  }
+#else
+  ptr = simulatedAlloc(bytes, tier);
+  if (!ptr && tier == External) {
+    ptr = simulatedAlloc(bytes, Internal);
+    if (ptr) fallbackCount++;
+  }
+#endif
+  return ptr;
+}
+
+// Grows or shrinks in place where the allocator can; otherwise moves the
+// block, preferring the requested tier.
+void* MemoryPolicy::reallocate(void* ptr, size_t bytes, Tier tier) {
+  if (!ptr) return allocate(bytes, tier);
+#ifdef ARDUINO
+  void* grown = heap_caps_realloc(ptr, bytes, capsFor(tier));
+  if (!grown && tier == External) {
+    grown = heap_caps_realloc(ptr, bytes, capsFor(Internal));
+    if (grown) fallbackCount++;
+  }
+  return grown;
+#else
+  void* moved = allocate(bytes, tier);
+  if (!moved) return nullptr;
+  size_t old = headerOf(ptr)->size;
+  memcpy(moved, ptr, old < bytes ? old : bytes);
+  release(ptr);
+  return moved;
+#endif
+}
+
+void MemoryPolicy::release(void* ptr) {
+  if (!ptr) return;
+#ifdef ARDUINO
+  heap_caps_free(ptr);
+#else
+  BlockHeader* block = headerOf(ptr);
+  used[block->tier] -= block->size;
+  free(block);
+#endif
+}
+
+size_t MemoryPolicy::freeBytes(Tier tier) {
+#ifdef ARDUINO
+  if (tier == External && !hasExternal()) return 0;
+  return heap_caps_get_free_size(capsFor(tier));
+#else
+  return used[tier] < budget[tier] ? budget[tier] - used[tier] : 0;
+#endif
+}
+
+size_t MemoryPolicy::largestFreeBlock(Tier tier) {
+#ifdef ARDUINO
+  if (tier == External && !hasExternal()) return 0;
+  return heap_caps_get_largest_free_block(capsFor(tier));
+#else
+  return freeBytes(tier);
+#endif
+}
+
+uint32_t MemoryPolicy::fallbacks() {
+  return fallbackCount;
+}
+
+const char* MemoryPolicy::name(Tier tier) {
+  return tier < TierCount ? kTierNames[tier] : "?";
+}
+
+#ifndef ARDUINO
+void MemoryPolicy::simulate(size_t internalBytes, size_t externalBytes) {
+  budget[Internal] = internalBytes;
+  budget[External] = externalBytes;
+  fallbackCount = 0;
+}
+
+MemoryPolicy::Tier MemoryPolicy::tierOf(const void* ptr) {
+  return headerOf(ptr)->tier;
+}
+
+size_t MemoryPolicy::usedBytes(Tier tier) {
+  return used[tier];
+}
+#endif
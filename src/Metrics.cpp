@@ -0,0 +1,170 @@
+#include "Metrics.h"
+#include "ArrivalHistory.h"
+#include "FlightRecorder.h"
+#include "HorizonStore.h"
+#include "LatencyTracer.h"
+#include "MemoryPolicy.h"
+#include "TimeManager.h"
+#include <cstdarg>
+
+namespace {
+WebServer httpServer(METRICS_PORT);
+char chunk[1024];
+
+void sendChunk(const char* data, size_t length, void*) {
+  httpServer.sendContent(data, length);
+}
+
+void handleMetrics() {
+  httpServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  httpServer.send(200, "text/plain; version=0.0.4", "");
+  MetricsWriter out(chunk, sizeof(chunk), sendChunk, nullptr);
+  Metrics::render(out);
+  out.flush();
+  httpServer.sendContent("");
+}
+}
+
+MetricsWriter::MetricsWriter(char* buf, size_t size, Sink sink, void* context)
+    : buf(buf), size(size), len(0), sink(sink), context(context) {}
+
+// Appends one formatted entry, flushing first if it does not fit. An entry
+// larger than the whole buffer is truncated.
+void MetricsWriter::printf(const char* format, ...) {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buf + len, size - len, format, args);
+    va_end(args);
+    if (n < 0) return;
+    if (len + n < size) {
+      len += n;
+      return;
+    }
+    if (len == 0) {
+      len = size - 1;
+      return;
+    }
+    flush();
+  }
+}
+
+void MetricsWriter::flush() {
+  if (len > 0) sink(buf, len, context);
+  len = 0;
+}
+
+void MetricsWriter::counter(const char* name, const char* help, unsigned long long value) {
+  printf("# HELP %s %s\n# TYPE %s counter\n%s %llu\n", name, help, name, name, value);
+}
+
+void MetricsWriter::gauge(const char* name, const char* help, unsigned long long value) {
+  printf("# HELP %s %s\n# TYPE %s gauge\n%s %llu\n", name, help, name, name, value);
+}
+
+void MetricsWriter::signedGauge(const char* name, const char* help, long long value) {
+  printf("# HELP %s %s\n# TYPE %s gauge\n%s %lld\n", name, help, name, name, value);
+}
+
+void MetricsWriter::ratio(const char* name, const char* help, uint32_t part, uint32_t total) {
+  printf("# HELP %s %s\n# TYPE %s gauge\n%s %.4f\n",
+         name, help, name, name, total > 0 ? static_cast<double>(part) / total : 0.0);
+}
+
+// A summary may only carry _sum, _count and quantiles, so the max is a
+// gauge family of its own.
+void MetricsWriter::duration(const char* name, const char* help, const DurationStat& stat) {
+  printf("# HELP %s_seconds %s\n# TYPE %s_seconds summary\n"
+         "%s_seconds_sum %.6f\n%s_seconds_count %lu\n",
+         name, help, name,
+         name, stat.sumUs / 1e6,
+         name, static_cast<unsigned long>(stat.count));
+  printf("# HELP %s_seconds_max Longest single sample of %s_seconds.\n# TYPE %s_seconds_max gauge\n"
+         "%s_seconds_max %.6f\n",
+         name, name, name,
+         name, stat.maxUs / 1e6);
+}
+
+// Series for one stage label; the caller writes HELP/TYPE once per family.
+void MetricsWriter::histogram(const char* name, const char* stage, const LatencyHistogram& hist) {
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+    cumulative += hist.buckets[i];
+    printf("%s_bucket{stage=\"%s\",le=\"%g\"} %lu\n", name, stage,
+           LatencyHistogram::kBoundsUs[i] / 1e6, static_cast<unsigned long>(cumulative));
+  }
+  cumulative += hist.buckets[LatencyHistogram::kBuckets];
+  printf("%s_bucket{stage=\"%s\",le=\"+Inf\"} %lu\n%s_sum{stage=\"%s\"} %.6f\n%s_count{stage=\"%s\"} %lu\n",
+         name, stage, static_cast<unsigned long>(cumulative),
+         name, stage, hist.sumUs / 1e6,
+         name, stage, static_cast<unsigned long>(hist.count));
+}
+
+void Metrics::begin() {
+  httpServer.on("/metrics", HTTP_GET, handleMetrics);
+  httpServer.begin();
+  Serial.printf("Metrics endpoint listening on port %d\n", METRICS_PORT);
+}
+
+void Metrics::poll() {
+  httpServer.handleClient();
+}
+
+// Shared with other diagnostics endpoints so the device runs one HTTP server.
+WebServer& Metrics::server() {
+  return httpServer;
+}
+
+void Metrics::render(MetricsWriter& out) {
+  out.counter("nycmap_messages_received_total", "WebSocket messages received.", messagesReceived);
+  out.counter("nycmap_bytes_received_total", "WebSocket payload bytes received.", bytesReceived);
+  out.counter("nycmap_parse_errors_total", "Payloads that failed to deserialize.", parseErrors);
+  out.counter("nycmap_messages_skipped_total", "Payloads identical to the previous one, not parsed.", messagesSkipped);
+  out.ratio("nycmap_message_skip_ratio", "Share of received payloads skipped as unchanged.", messagesSkipped, messagesReceived);
+  out.counter("nycmap_stations_updated_total", "Station records applied from the feed.", stationsUpdated);
+  out.counter("nycmap_stations_skipped_total", "Station records unchanged since last applied.", stationsSkipped);
+  out.counter("nycmap_stations_rejected_total", "Station records from a stale generation or unknown feed.", stationsRejected);
+  out.ratio("nycmap_station_skip_ratio", "Share of station records skipped as unchanged.",
+            stationsSkipped, stationsSkipped + stationsUpdated);
+  out.counter("nycmap_trains_added_total", "Arrivals added to a station.", trainsAdded);
+  out.counter("nycmap_trains_replaced_total", "Pending arrivals dropped when a newer generation replaced their list.", trainsReplaced);
+  out.counter("nycmap_trains_out_of_window_total", "Arrivals rejected as too old or too far ahead.", trainsOutOfWindow);
+  out.counter("nycmap_trains_purged_total", "Arrivals purged after their window ended.", trainsPurged);
+  out.counter("nycmap_trains_promoted_total", "Arrivals moved from the horizon store into the live window.", trainsPromoted);
+  out.gauge("nycmap_horizon_entries", "Arrivals held in the horizon store.", HorizonStore::used());
+  out.gauge("nycmap_horizon_capacity_entries", "Horizon store capacity.", HORIZON_CAPACITY);
+  out.counter("nycmap_horizon_dropped_total", "Arrivals that did not fit the horizon store.", HorizonStore::dropped());
+  out.counter("nycmap_wifi_reconnects_total", "WiFi reconnect attempts.", wifiReconnects);
+  out.counter("nycmap_websocket_reconnects_total", "WebSocket reconnect attempts.", websocketReconnects);
+  out.duration("nycmap_parse", "Time spent parsing and applying a message.", parseTime);
+  out.duration("nycmap_loop", "Active (non-idle) time per main loop iteration.", loopTime);
+  out.duration("nycmap_show", "Loop time spent handing a frame to the strip.", showTime);
+  out.duration("nycmap_show_transfer", "Time the strip takes to clock out a frame (with LED_ASYNC_SHOW, recorded when the next frame is presented).", showTransferTime);
+  out.counter("nycmap_mirror_frames_total", "Frames streamed to the mirror viewer.", mirrorFrames);
+  out.counter("nycmap_mirror_bytes_total", "Encoded mirror bytes sent.", mirrorBytes);
+  out.duration("nycmap_mirror_encode", "Time to diff and encode a mirror frame.", mirrorEncodeTime);
+  out.counter("nycmap_history_events_total", "Arrivals written to the history log.", ArrivalHistory::eventCount());
+  out.gauge("nycmap_history_bytes", "History log bytes in use.", ArrivalHistory::bytesUsed());
+  out.gauge("nycmap_history_oldest_seconds", "Epoch of the oldest logged arrival.", ArrivalHistory::oldestTime());
+  out.gauge("nycmap_heap_free_bytes", "Free internal heap.", ESP.getFreeHeap());
+  out.gauge("nycmap_heap_largest_free_block_bytes", "Largest allocatable heap block.", ESP.getMaxAllocHeap());
+  out.gauge("nycmap_psram_free_bytes", "Free PSRAM.", MemoryPolicy::freeBytes(MemoryPolicy::External));
+  out.counter("nycmap_psram_fallbacks_total", "PSRAM requests served from internal RAM.", MemoryPolicy::fallbacks());
+  out.gauge("nycmap_uptime_seconds", "Seconds since boot.", millis() / 1000);
+  out.gauge("nycmap_clock_source", "What set the clock: 0 nothing, 1 feed sent_ms, 2 NTP.", TimeManager::source());
+  out.signedGauge("nycmap_clock_feed_offset_ms", "Last feed server minus device clock estimate.", TimeManager::feedOffsetMs());
+  out.signedGauge("nycmap_clock_ntp_offset_ms", "NTP minus device clock at the last NTP sync.", TimeManager::ntpOffsetMs());
+  out.counter("nycmap_clock_steps_total", "Clock steps.", TimeManager::clockSteps());
+  out.counter("nycmap_clock_slews_total", "Clock slews.", TimeManager::clockSlews());
+  out.counter("nycmap_boots_total", "Boots since power-on.", FlightRecorder::bootCount());
+  out.gauge("nycmap_reset_reason", "esp_reset_reason() of the last boot.", FlightRecorder::resetReason());
+  out.gauge("nycmap_latency_last_message_id", "ID of the last traced feed message.", LatencyTracer::lastMessageId());
+  out.counter("nycmap_latency_missed_messages_total", "Gaps in feed message IDs.", LatencyTracer::missedMessages());
+  out.counter("nycmap_latency_clock_skew_total", "Cross-clock stages that came out negative.", LatencyTracer::clockSkewSamples());
+  out.printf("# HELP nycmap_latency_seconds Feed message latency by pipeline stage.\n"
+             "# TYPE nycmap_latency_seconds histogram\n");
+  for (uint8_t stage = 0; stage < LatencyTracer::StageCount; ++stage) {
+    auto s = static_cast<LatencyTracer::Stage>(stage);
+    out.histogram("nycmap_latency_seconds", LatencyTracer::stageName(s), LatencyTracer::histogram(s));
+  }
+}
@@ -2,6 +2,13 @@
 #include <Arduino.h>
 #include "MTAManager.h"
 #include <WiFi.h>
+#include "Metrics.h"
+#include "FlightRecorder.h"
+#include "LatencyTracer.h"
+#include "AllocTracker.h"
+#include "TimeScrub.h"
+#include "FrameMirror.h"
+#include "LEDManager.h"
 
 NetworkManager::NetworkManager(const char* ssid, const char* password, const char* host, const char* port)
     : ssid(ssid),
@@ -26,7 +33,11 @@ NetworkManager::NetworkManager(const char* ssid, const char* password, const cha
 void NetworkManager::initializeWifi() {
   WiFi.mode(WIFI_STA);
   WiFi.persistent(false);
+#ifdef LIGHT_SLEEP
+  WiFi.setSleep(true);           // modem sleep is required for automatic light sleep
+#else
   WiFi.setSleep(false);          // prevent modem sleep latency spikes
+#endif
   WiFi.setAutoReconnect(true);   // retry automatically
   WiFi.begin(ssid, password);
   Serial.println("Connecting to WiFi");
@@ -60,6 +71,7 @@ bool NetworkManager::checkWifiConnection() {
 void NetworkManager::handleWifiConnected() {
     if (!wifiConnectionStatus) {
         wifiConnectionStatus = true;
+        FlightRecorder::log(FlightRecorder::Wifi, 1, 0);
         Serial.println("Connected");
     }
     wifiBackoffMs = 1000;
@@ -69,6 +81,7 @@ void NetworkManager::handleWifiConnected() {
 void NetworkManager::handleWifiDisconnected() {
     if (wifiConnectionStatus) {
         Serial.println("WiFi lost");
+        FlightRecorder::log(FlightRecorder::Wifi, 0, 0);
     }
     wifiConnectionStatus = false;
 }
@@ -77,6 +90,7 @@ void NetworkManager::attemptWifiReconnect() {
     unsigned long now = millis();
     if (now - wifiLastAttempt >= wifiBackoffMs) {
         Serial.println("Attempting WiFi reconnect...");
+        Metrics::wifiReconnects++;
         WiFi.disconnect(true);
         delay(50);
         WiFi.begin(ssid, password);
@@ -93,12 +107,13 @@ void NetworkManager::attemptWifiReconnect() {
 void NetworkManager::handleMaxWifiFailures() {
     if (wifiFailedAttempts >= 5) {
         Serial.println("Max WiFi reconnect attempts reached. Rebooting ESP32...");
+        FlightRecorder::log(FlightRecorder::Restart, FlightRecorder::WifiFailures, wifiFailedAttempts);
         ESP.restart();
     }
 }
 
 void NetworkManager::initializeWebsocket() {
-  wsClient.onMessage([this](websockets::WebsocketsMessage msg) {
+  wsClient.onMessage([this](websockets::WebsocketsClient&, websockets::WebsocketsMessage msg) {
     this->onWebSocketMessage(msg);
   });
   wsClient.onEvent([](websockets::WebsocketsEvent e, String data){
@@ -127,7 +142,12 @@ bool NetworkManager::checkWebsocketConnection() {
 
 void NetworkManager::handleWebsocketDisconnect() {
   // Use member variables for state
+  if (websocketWasConnected) {
+    FlightRecorder::log(FlightRecorder::WebSocket, 0, 0);
+  }
   websocketWasConnected = false;
+  FrameMirror::setEnabled(false);
+  MtaManager::resetGenerations();
   unsigned long now = millis();
   if (now - websocketLastAttempt >= websocketBackoffMs) {
     attemptWebsocketReconnect();
@@ -136,6 +156,7 @@ void NetworkManager::handleWebsocketDisconnect() {
 
 void NetworkManager::attemptWebsocketReconnect() {
   Serial.println("WS disconnected, attempting reconnect...");
+  Metrics::websocketReconnects++;
   wsClient.close();
   delay(20);
   String wsUrl = "ws://" + String(host) + ":" + String(port) + "/ws";
@@ -149,6 +170,7 @@ void NetworkManager::attemptWebsocketReconnect() {
     if (websocketFailedAttempts >= 5) {
       if (isServerPingable()) {
         Serial.println("Server is pingable. Rebooting ESP32...");
+        FlightRecorder::log(FlightRecorder::Restart, FlightRecorder::WebsocketFailures, websocketFailedAttempts);
         ESP.restart();
       } else {
         Serial.println("Server is not pingable. Not rebooting.");
@@ -171,6 +193,7 @@ void NetworkManager::handleWebsocketConnected() {
   websocketBackoffMs = 1000;
   websocketFailedAttempts = 0;
   if (!websocketWasConnected) {
+    FlightRecorder::log(FlightRecorder::WebSocket, 1, 0);
     if (websocketEverConnected) {
       Serial.println("WS reconnected");
     } else {
@@ -185,12 +208,34 @@ void NetworkManager::handleWebsocketConnected() {
   }
 }
 
-void NetworkManager::onWebSocketMessage(websockets::WebsocketsMessage msg) {
+void NetworkManager::onWebSocketMessage(websockets::WebsocketsMessage& msg) {
+  // The message already owns its payload as a std::string. Hand that buffer
+  // to the parser to tokenize in place instead of going through data(), which
+  // copies it into an Arduino String first.
+  std::string& payload = const_cast<std::string&>(msg.rawData());
+  if (payload.empty()) return;
+  if (TimeScrub::handleMessage(payload.data(), payload.size())) return;
+  if (FrameMirror::handleMessage(payload.data(), payload.size())) return;
+  LatencyTracer::received();
+  Metrics::messagesReceived++;
+  Metrics::bytesReceived += payload.size();
+  FlightRecorder::log(FlightRecorder::Message, 0, payload.size());
 #ifdef DEBUG
   Serial.print("WebSocket message: ");
-  Serial.println(msg.data());
+  Serial.write(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+  Serial.println();
 #endif
-  MtaManager::parseData(msg);
+  AllocTracker::Scope scope(AllocTracker::Parse);
+  MtaManager::parseData(&payload[0], payload.size());
+}
+
+// Sends the current frame to the server if mirroring is on and a frame is due.
+void NetworkManager::sendMirrorFrame() {
+  size_t length = FrameMirror::encode(LEDManager::leds);
+  if (length) {
+    FrameMirror::commit(wsClient.available() &&
+                        wsClient.sendBinary(reinterpret_cast<const char*>(FrameMirror::data()), length));
+  }
 }
 
 void NetworkManager::poll() {
@@ -0,0 +1,86 @@
+#include "PowerManager.h"
+
+#if defined(LIGHT_SLEEP) && CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+
+TaskHandle_t PowerManager::loopTask = nullptr;
+unsigned long PowerManager::windowStartUs = 0;
+unsigned long PowerManager::idleUs = 0;
+unsigned long PowerManager::loopCount = 0;
+
+void PowerManager::initialize() {
+  loopTask = xTaskGetCurrentTaskHandle();
+  resetStats();
+
+#ifdef LIGHT_SLEEP
+#if CONFIG_PM_ENABLE
+  // Let the idle task drop into light sleep while the loop is blocked.
+  // Requires WiFi modem sleep, which NetworkManager enables under LIGHT_SLEEP.
+  esp_pm_config_esp32s3_t pm = {};
+  pm.max_freq_mhz = 240;
+  pm.min_freq_mhz = 80;
+  pm.light_sleep_enable = true;
+  esp_err_t err = esp_pm_configure(&pm);
+  if (err != ESP_OK) {
+    Serial.printf("esp_pm_configure() failed: %d, idling without light sleep\n", err);
+  }
+#else
+  Serial.println("LIGHT_SLEEP set but this core lacks CONFIG_PM_ENABLE, idling without light sleep");
+#endif
+#endif
+}
+
+// Blocks the loop task until the next scheduled change, a wake() notification,
+// or the poll slice elapses, whichever comes first.
+void PowerManager::idleFor(unsigned long waitMs) {
+  loopCount++;
+  if (waitMs > POWER_POLL_SLICE_MS) waitMs = POWER_POLL_SLICE_MS;
+  if (waitMs == 0 || loopTask == nullptr) {
+    yield();
+    return;
+  }
+
+  unsigned long start = micros();
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+  idleUs += micros() - start;
+}
+
+void PowerManager::wake() {
+  if (loopTask) xTaskNotifyGive(loopTask);
+}
+
+void PowerManager::wakeFromISR() {
+  if (!loopTask) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(loopTask, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+float PowerManager::dutyCyclePercent() {
+  unsigned long elapsed = micros() - windowStartUs;
+  if (elapsed == 0 || idleUs >= elapsed) return 0.0f;
+  return static_cast<float>(elapsed - idleUs) * 100.0f / elapsed;
+}
+
+float PowerManager::estimatedCurrentMa() {
+  float duty = dutyCyclePercent() / 100.0f;
+  return duty * POWER_ACTIVE_MA + (1.0f - duty) * POWER_IDLE_MA;
+}
+
+void PowerManager::printPowerUsage() {
+  unsigned long elapsedMs = (micros() - windowStartUs) / 1000;
+  float loopsPerSec = elapsedMs > 0 ? loopCount * 1000.0f / elapsedMs : 0.0f;
+  Serial.printf("[Power] Duty: %.1f%%, Loops: %lu (%.1f/s), Est. draw: %.0f mA\n",
+                dutyCyclePercent(),
+                loopCount,
+                loopsPerSec,
+                estimatedCurrentMa());
+  resetStats();
+}
+
+void PowerManager::resetStats() {
+  windowStartUs = micros();
+  idleUs = 0;
+  loopCount = 0;
+}
@@ -0,0 +1,95 @@
+#include "ServiceFrequency.h"
+#include <sys/time.h>
+#include "StationMap.h"
+
+namespace {
+// Anything earlier means SNTP has not set the clock yet.
+constexpr time_t kClockValid = 1577836800;  // 2020-01-01
+
+constexpr uint32_t kWindowSeconds = HEAT_WINDOW_MINUTES * 60UL;
+
+// Colour ramp stops, evenly spaced over 0..255.
+const uint32_t kRamp[] = {0x0000ff, 0x00c0ff, 0x00ff40, 0xffe000, 0xff0000};
+constexpr size_t kRampSegments = sizeof(kRamp) / sizeof(kRamp[0]) - 1;
+
+uint32_t scaleFor(uint32_t coveredSeconds) {
+  return static_cast<uint32_t>((255ULL * 3600 << 16) / (static_cast<uint64_t>(HEAT_FULL_SCALE_TPH) * coveredSeconds));
+}
+}
+
+uint32_t ServiceFrequency::currentBucket = 0;
+uint32_t ServiceFrequency::firstBucket = 0;
+uint32_t ServiceFrequency::levelScale = scaleFor(kWindowSeconds);
+
+void ServiceFrequency::record(ServiceCounter& counter) {
+  if (currentBucket == 0) return;
+  uint8_t& bucket = counter.buckets[currentBucket % HEAT_BUCKETS];
+  if (bucket == UINT8_MAX) return;
+  bucket++;
+  counter.total++;
+}
+
+bool ServiceFrequency::advance(time_t now) {
+  if (now < kClockValid) return false;
+  uint32_t bucket = static_cast<uint32_t>(now / kBucketSeconds);
+  if (bucket == currentBucket) return false;
+
+  if (currentBucket == 0 || bucket < currentBucket || bucket - currentBucket >= HEAT_BUCKETS) {
+    // First valid time, a clock step back, or a gap longer than the window:
+    // nothing in the buckets is still in range.
+    for (uint32_t slot = 0; slot < HEAT_BUCKETS; ++slot) retire(slot);
+    if (currentBucket == 0 || bucket < currentBucket) firstBucket = bucket;
+  } else {
+    for (uint32_t b = currentBucket + 1; b <= bucket; ++b) retire(b % HEAT_BUCKETS);
+  }
+  currentBucket = bucket;
+
+  uint32_t covered = (currentBucket - firstBucket + 1) * kBucketSeconds;
+  levelScale = scaleFor(covered < kWindowSeconds ? covered : kWindowSeconds);
+  return true;
+}
+
+bool ServiceFrequency::isAdvanceDue(time_t now) {
+  return now >= kClockValid && static_cast<uint32_t>(now / kBucketSeconds) != currentBucket;
+}
+
+unsigned long ServiceFrequency::msUntilNextBucket() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (tv.tv_sec < kClockValid) return kBucketSeconds * 1000UL;
+  uint32_t intoBucket = static_cast<uint32_t>(tv.tv_sec % kBucketSeconds);
+  return (kBucketSeconds - intoBucket) * 1000UL - tv.tv_usec / 1000;
+}
+
+uint8_t ServiceFrequency::level(const ServiceCounter& counter) {
+  uint64_t scaled = (static_cast<uint64_t>(counter.total) * levelScale) >> 16;
+  return scaled > 255 ? 255 : static_cast<uint8_t>(scaled);
+}
+
+uint32_t ServiceFrequency::trainsPerHour(const ServiceCounter& counter) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(counter.total) * levelScale * HEAT_FULL_SCALE_TPH / 255) >> 16);
+}
+
+uint32_t ServiceFrequency::color(uint8_t level) {
+  uint32_t pos = static_cast<uint32_t>(level) * kRampSegments;
+  uint32_t segment = pos / 255;
+  if (segment >= kRampSegments) return kRamp[kRampSegments];
+  uint32_t t = pos % 255;
+  uint32_t from = kRamp[segment];
+  uint32_t to = kRamp[segment + 1];
+  uint32_t rgb = 0;
+  for (int shift = 0; shift <= 16; shift += 8) {
+    int a = (from >> shift) & 0xFF;
+    int b = (to >> shift) & 0xFF;
+    rgb |= static_cast<uint32_t>(a + (b - a) * static_cast<int>(t) / 255) << shift;
+  }
+  return rgb;
+}
+
+void ServiceFrequency::retire(uint32_t slot) {
+  for (Station& station : StationMap::stations) {
+    ServiceCounter& counter = station.frequency;
+    counter.total -= counter.buckets[slot];
+    counter.buckets[slot] = 0;
+  }
+}
@@ -1,6 +1,6 @@
 #include "Station.h"
 
-Station::Station() : id(""), name("") {}
+Station::Station() : id(""), name(""), presentRoutes(0), routeMask(0), feedDigest(0), digestExpires(0), frequency{} {}
 
-Station::Station(const std::string& id, const std::string& name)
-    : id(id), name(name) {}
\ No newline at end of file
+Station::Station(const char* id, const char* name)
+    : id(id), name(name), presentRoutes(0), routeMask(0), feedDigest(0), digestExpires(0), frequency{} {}
@@ -0,0 +1,55 @@
+#include "StationMap.h"
+#include <cstring>
+#include "GeneratedStationMap.h"
+#include "LEDManager.h"
+
+static_assert(GENERATED_LED_COUNT <= NUM_LEDS_SUBWAY, "station map has more LEDs than the strip");
+
+StationMap::StationList StationMap::stations;
+StationLayout StationMap::layout = {};
+
+void StationMap::useGenerated() {
+  stations.clear();
+  stations.reserve(GENERATED_STATION_COUNT);
+  for (size_t i = 0; i < GENERATED_STATION_COUNT; ++i) {
+    stations.emplace_back(generatedStationIds[i], generatedStationNames[i]);
+  }
+  use({GENERATED_LED_COUNT, GENERATED_COMPLEX_COUNT,
+       generatedStationLedStart, generatedStationLeds,
+       generatedLedComplex, generatedComplexIds});
+}
+
+// The caller fills stations first; tables must cover them.
+void StationMap::use(const StationLayout& tables) {
+  layout = tables;
+}
+
+int StationMap::indexOf(const char* id) {
+  if (!id) return -1;
+  size_t lo = 0;
+  size_t hi = stations.size();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    int cmp = strcmp(stations[mid].id, id);
+    if (cmp == 0) return static_cast<int>(mid);
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return -1;
+}
+
+Station* StationMap::find(const char* id) {
+  int index = indexOf(id);
+  return index >= 0 ? &stations[index] : nullptr;
+}
+
+uint16_t StationMap::complexOf(uint16_t led) {
+  return led < layout.ledCount ? layout.ledComplex[led] : kNoComplex;
+}
+
+const char* StationMap::complexId(uint16_t complex) {
+  return complex < layout.complexCount ? layout.complexIds[complex] : "";
+}
@@ -0,0 +1,130 @@
+#include "StationMapImage.h"
+#include <Arduino.h>
+#include <cstring>
+#include <esp_partition.h>
+#include "LEDManager.h"
+#include "StationMap.h"
+
+const StationMapHeader* StationMapImage::header = nullptr;
+
+namespace {
+template <typename T>
+const T* section(const uint8_t* data, uint32_t offset) {
+  return reinterpret_cast<const T*>(data + offset);
+}
+
+// Whether [offset, offset + bytes) lies within the image and is 2-byte aligned.
+bool sectionFits(const StationMapHeader* h, uint32_t offset, size_t bytes) {
+  return offset >= sizeof(StationMapHeader) && (offset & 1) == 0 &&
+         offset <= h->totalSize && bytes <= h->totalSize - offset;
+}
+}
+
+// Maps the station map partition and, if it holds a valid image, points
+// StationMap at it. Returns false (and leaves StationMap alone) otherwise.
+bool StationMapImage::load() {
+  const esp_partition_t* part = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, STATION_MAP_PARTITION_LABEL);
+  if (!part) {
+    Serial.println("No stationmap partition, using compiled-in station map");
+    return false;
+  }
+
+  const void* mapped = nullptr;
+  spi_flash_mmap_handle_t handle;
+  if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+    Serial.println("stationmap mmap failed, using compiled-in station map");
+    return false;
+  }
+
+  const uint8_t* data = static_cast<const uint8_t*>(mapped);
+  if (!validate(data, part->size)) {
+    spi_flash_munmap(handle);
+    Serial.println("stationmap image invalid, using compiled-in station map");
+    return false;
+  }
+
+  header = reinterpret_cast<const StationMapHeader*>(data);
+  const StationMapEntry* entries = section<StationMapEntry>(data, sizeof(StationMapHeader));
+  const char* names = section<char>(data, header->nameOffset);
+
+  // Station objects still own their train lists, but id/name now reference
+  // the mapped image. The mapping is kept for the lifetime of the firmware.
+  StationMap::stations.clear();
+  StationMap::stations.reserve(header->stationCount);
+  for (uint16_t i = 0; i < header->stationCount; ++i) {
+    StationMap::stations.emplace_back(entries[i].id, names + entries[i].nameOffset);
+  }
+  StationMap::use({header->ledCount, header->complexCount,
+                   section<uint16_t>(data, header->ledStartOffset),
+                   section<uint16_t>(data, header->ledsOffset),
+                   section<uint16_t>(data, header->ledComplexOffset),
+                   section<char[4]>(data, header->complexOffset)});
+
+  Serial.printf("Loaded station map image v%u: %u stations, %u LEDs, %u complexes, %lu bytes\n",
+                header->version,
+                header->stationCount,
+                header->ledCount,
+                header->complexCount,
+                static_cast<unsigned long>(header->totalSize));
+  return true;
+}
+
+bool StationMapImage::validate(const uint8_t* data, size_t size) {
+  if (size < sizeof(StationMapHeader)) return false;
+  const StationMapHeader* h = reinterpret_cast<const StationMapHeader*>(data);
+  if (h->magic != STATION_MAP_IMAGE_MAGIC || h->version != STATION_MAP_IMAGE_VERSION) return false;
+  if (h->totalSize > size || h->totalSize < sizeof(StationMapHeader)) return false;
+  // Every LED index the image yields is written to leds[] unchecked, so the
+  // image may not address past the strip.
+  if (h->ledCount > NUM_LEDS_SUBWAY) return false;
+
+  const size_t stationCount = h->stationCount;
+  if (!sectionFits(h, sizeof(StationMapHeader), stationCount * sizeof(StationMapEntry))) return false;
+  if (!sectionFits(h, h->ledStartOffset, (stationCount + 1) * sizeof(uint16_t))) return false;
+  const uint16_t* ledStart = section<uint16_t>(data, h->ledStartOffset);
+  const size_t fanout = ledStart[stationCount];
+  if (!sectionFits(h, h->ledsOffset, fanout * sizeof(uint16_t))) return false;
+  if (!sectionFits(h, h->ledComplexOffset, h->ledCount * sizeof(uint16_t))) return false;
+  if (!sectionFits(h, h->complexOffset, h->complexCount * 4UL)) return false;
+  if (h->nameOffset > h->totalSize || h->nameSize > h->totalSize - h->nameOffset) return false;
+  if (h->nameSize == 0 || data[h->nameOffset + h->nameSize - 1] != '\0') return false;
+
+  const StationMapEntry* e = section<StationMapEntry>(data, sizeof(StationMapHeader));
+  for (size_t i = 0; i < stationCount; ++i) {
+    if (e[i].id[3] != '\0' || e[i].nameOffset >= h->nameSize) return false;
+    if (i > 0 && strncmp(e[i - 1].id, e[i].id, sizeof(e[i].id)) >= 0) return false;
+    if (ledStart[i] > ledStart[i + 1]) return false;
+  }
+  if (ledStart[0] != 0) return false;
+
+  const uint16_t* leds = section<uint16_t>(data, h->ledsOffset);
+  for (size_t i = 0; i < fanout; ++i) {
+    if (leds[i] >= h->ledCount) return false;
+  }
+  const uint16_t* ledComplex = section<uint16_t>(data, h->ledComplexOffset);
+  for (size_t i = 0; i < h->ledCount; ++i) {
+    if (ledComplex[i] >= h->complexCount && ledComplex[i] != StationMap::kNoComplex) return false;
+  }
+  const char* complexIds = section<char>(data, h->complexOffset);
+  for (size_t i = 0; i < h->complexCount; ++i) {
+    if (complexIds[i * 4 + 3] != '\0') return false;
+  }
+
+  return crc32(data + sizeof(StationMapHeader), h->totalSize - sizeof(StationMapHeader)) == h->crc32;
+}
+
+bool StationMapImage::isLoaded() {
+  return header != nullptr;
+}
+
+uint32_t StationMapImage::crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+    }
+  }
+  return ~crc;
+}
@@ -1,4 +1,14 @@
 #include "SubwayColors.h"
+#include <cstring>
+
+namespace {
+const char* const kRouteIds[SubwayColorMap::kRouteCount] = {
+    "1", "2", "3", "4", "5", "5X", "6", "6X", "7", "7X",
+    "A", "B", "C", "D", "E", "F", "FX", "FS", "G", "GS",
+    "H", "J", "L", "M", "N", "Q", "R", "S", "SI", "W",
+    "Z"
+};
+}
 
 SubwayColorMap::SubwayColorMap() {
     routeColors = {
@@ -16,6 +26,10 @@ SubwayColorMap::SubwayColorMap() {
         {"R", Yellow}, {"S", Turquoise},
         {"SI", Gray},  {"W", Turquoise}
     };
+    for (uint8_t i = 0; i < kRouteCount; ++i) {
+        codeColors[i] = getColor(kRouteIds[i]);
+    }
+    codeColors[kUnknownRoute] = Default;
 }
 
 SubwayColorMap::SubwayColor SubwayColorMap::getColor(const std::string& routeId) const {
@@ -24,4 +38,20 @@ SubwayColorMap::SubwayColor SubwayColorMap::getColor(const std::string& routeId)
         return it->second;
     }
     return Default;
-}
\ No newline at end of file
+}
+
+uint8_t SubwayColorMap::routeCode(const char* routeId) {
+    if (!routeId) return kUnknownRoute;
+    for (uint8_t i = 0; i < kRouteCount; ++i) {
+        if (strcmp(kRouteIds[i], routeId) == 0) return i;
+    }
+    return kUnknownRoute;
+}
+
+const char* SubwayColorMap::routeName(uint8_t code) {
+    return code < kRouteCount ? kRouteIds[code] : "?";
+}
+
+SubwayColorMap::SubwayColor SubwayColorMap::colorForCode(uint8_t code) const {
+    return code <= kUnknownRoute ? codeColors[code] : Default;
+}
@@ -1,8 +1,82 @@
 #include "TimeManager.h"
 #include <time.h>
+#include <sys/time.h>
 #include <Arduino.h>
+#include <esp_sntp.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <cstdlib>
+#include "PowerManager.h"
 
+namespace {
+// Anything earlier means nothing has set the clock yet.
+constexpr time_t kClockValidAfter = 1577836800;  // 2020-01-01
+
+// A source that has set the clock stays authoritative for this long after
+// its last sample; NTP takes over again if the feed goes quiet.
+constexpr uint32_t kFeedAuthorityMs = 10UL * 60 * 1000;
+
+uint32_t lastFeedSampleMs = 0;
+
+struct NtpSample {
+  struct timeval time;
+  uint32_t receivedUs;
+};
+
+// One slot, written by the lwIP task and drained by poll(). A newer result
+// overwrites one the loop has not picked up yet.
+QueueHandle_t ntpSamples = nullptr;
+
+int64_t nowMs() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's
+// days_from_civil).
+int64_t daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Reads exactly n digits.
+bool digits(const char*& p, int n, int* out) {
+  int v = 0;
+  for (int i = 0; i < n; ++i, ++p) {
+    if (*p < '0' || *p > '9') return false;
+    v = v * 10 + (*p - '0');
+  }
+  *out = v;
+  return true;
+}
+}
+
+// lwIP calls this with each SNTP result in place of setting the clock itself.
+// It runs on the lwIP task, so it only hands the sample to the loop.
+extern "C" void sntp_sync_time(struct timeval* tv) {
+  if (!ntpSamples) return;
+  NtpSample sample = {*tv, static_cast<uint32_t>(micros())};
+  xQueueOverwrite(ntpSamples, &sample);
+  PowerManager::wake();
+}
+
+TimeManager::Source TimeManager::clockSource = TimeManager::Unset;
+int64_t TimeManager::windowBestMs = 0;
+uint8_t TimeManager::windowSamples = 0;
+int64_t TimeManager::lastFeedOffsetMs = 0;
+int64_t TimeManager::lastNtpOffsetMs = 0;
+uint32_t TimeManager::steps = 0;
+uint32_t TimeManager::slews = 0;
+
+// Starts SNTP and sets the zone, without waiting for a sync: the first feed
+// message usually sets the clock first.
 void TimeManager::initializeTime() {
+  ntpSamples = xQueueCreate(1, sizeof(NtpSample));
   configTime(0, 0, "pool.ntp.org", "time.nist.gov");
 
   // Set the POSIX timezone string for US Eastern Time.
@@ -12,13 +86,7 @@ void TimeManager::initializeTime() {
   setenv("TZ", "EST5EDT,M3.2.0/2,M11.1.0/2", 1);
   tzset();
 
-  Serial.println("Attempting to initialize time with TZ string for automatic DST...");
-  struct tm timeinfo;
-  if (!getLocalTime(&timeinfo)) {
-    Serial.println("Failed to obtain time after setting TZ environment variable.");
-    return;
-  }
-  Serial.println(&timeinfo, "Time initialized: %A, %B %d %Y %H:%M:%S %Z (%z)");
+  Serial.println("Timezone set; clock will be set from the feed or NTP, whichever answers first");
 }
 
 void TimeManager::printCurrentTime() {
@@ -29,5 +97,145 @@ void TimeManager::printCurrentTime() {
   char buf[64];
   strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %Z", &timeinfo);
   Serial.print("Current time: ");
-  Serial.println(buf);
-}
\ No newline at end of file
+  Serial.print(buf);
+  Serial.printf(" (source %s, feed offset %lld ms, NTP offset %lld ms)\n",
+                clockSource == Feed ? "feed" : clockSource == Ntp ? "ntp" : "unset",
+                static_cast<long long>(lastFeedOffsetMs),
+                static_cast<long long>(lastNtpOffsetMs));
+}
+
+// Each sample is sent_ms minus the device clock at receipt. Network delay
+// only ever makes it smaller, so the largest sample in a window is the best
+// estimate of the true offset.
+void TimeManager::onServerTime(int64_t serverMs, uint32_t receivedUs) {
+  if (serverMs <= 0) return;
+  int64_t localMs = nowMs() - static_cast<int64_t>(micros() - receivedUs) / 1000;
+  int64_t sampleMs = serverMs - localMs;
+  lastFeedSampleMs = millis();
+
+  if (!isTimeValid() || clockSource != Feed) {
+    // First sample, or taking over from NTP: no point slewing toward it.
+    step(sampleMs);
+    clockSource = Feed;
+    lastFeedOffsetMs = sampleMs;
+    windowSamples = 0;
+    return;
+  }
+
+  if (windowSamples == 0 || sampleMs > windowBestMs) windowBestMs = sampleMs;
+  if (++windowSamples < FEED_CLOCK_WINDOW) return;
+  windowSamples = 0;
+  lastFeedOffsetMs = windowBestMs;
+
+  int64_t magnitude = windowBestMs < 0 ? -windowBestMs : windowBestMs;
+  if (magnitude >= FEED_CLOCK_STEP_MS) {
+    step(windowBestMs);
+  } else if (magnitude > FEED_CLOCK_DEADBAND_MS) {
+    struct timeval delta;
+    delta.tv_sec = static_cast<time_t>(windowBestMs / 1000);
+    delta.tv_usec = static_cast<suseconds_t>((windowBestMs % 1000) * 1000);
+    adjtime(&delta, nullptr);
+    slews++;
+  }
+}
+
+void TimeManager::poll() {
+  NtpSample sample;
+  if (ntpSamples && xQueueReceive(ntpSamples, &sample, 0) == pdTRUE) {
+    onNtpTime(sample.time, sample.receivedUs);
+  }
+}
+
+// Sets the clock from NTP only while the feed isn't keeping it; otherwise
+// just records how far apart the two are. The time is carried forward by how
+// long the sample waited for the loop.
+void TimeManager::onNtpTime(const struct timeval& ntp, uint32_t receivedUs) {
+  int64_t ntpMs = static_cast<int64_t>(ntp.tv_sec) * 1000 + ntp.tv_usec / 1000 +
+                  static_cast<int64_t>(micros() - receivedUs) / 1000;
+  lastNtpOffsetMs = ntpMs - nowMs();
+  bool feedActive = clockSource == Feed && millis() - lastFeedSampleMs < kFeedAuthorityMs;
+  if (!feedActive) {
+    step(lastNtpOffsetMs);
+    clockSource = Ntp;
+    return;
+  }
+  if (llabs(lastNtpOffsetMs) >= FEED_CLOCK_STEP_MS) {
+    Serial.printf("NTP disagrees with feed clock by %lld ms\n", static_cast<long long>(lastNtpOffsetMs));
+  }
+}
+
+bool TimeManager::isTimeValid() {
+  return time(nullptr) >= kClockValidAfter;
+}
+
+TimeManager::Source TimeManager::source() {
+  return clockSource;
+}
+
+int64_t TimeManager::feedOffsetMs() {
+  return lastFeedOffsetMs;
+}
+
+int64_t TimeManager::ntpOffsetMs() {
+  return lastNtpOffsetMs;
+}
+
+uint32_t TimeManager::clockSteps() {
+  return steps;
+}
+
+uint32_t TimeManager::clockSlews() {
+  return slews;
+}
+
+bool TimeManager::parseFeedTime(const char* text, time_t* out) {
+  if (!text) return false;
+  const char* p = text;
+  int year, month, day, hour, minute, second;
+  if (!digits(p, 4, &year) || *p++ != '-' || !digits(p, 2, &month) || *p++ != '-' ||
+      !digits(p, 2, &day) || (*p != 'T' && *p != ' ') || !digits(++p, 2, &hour) ||
+      *p++ != ':' || !digits(p, 2, &minute) || *p++ != ':' || !digits(p, 2, &second)) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+    return false;
+  }
+  if (*p == '.') {
+    while (*++p >= '0' && *p <= '9') {}
+  }
+
+  int64_t epoch = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+  if (*p == 'Z') {
+    // UTC
+  } else if (*p == '+' || *p == '-') {
+    int sign = *p++ == '-' ? -1 : 1;
+    int offHour, offMinute;
+    if (!digits(p, 2, &offHour)) return false;
+    if (*p == ':') p++;
+    if (!digits(p, 2, &offMinute)) return false;
+    epoch -= sign * (offHour * 3600 + offMinute * 60);
+  } else {
+    // No offset: local time, letting the TZ rules pick DST.
+    struct tm tm = {};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = second;
+    tm.tm_isdst = -1;
+    *out = mktime(&tm);
+    return *out != static_cast<time_t>(-1);
+  }
+  *out = static_cast<time_t>(epoch);
+  return true;
+}
+
+void TimeManager::step(int64_t deltaMs) {
+  int64_t targetMs = nowMs() + deltaMs;
+  struct timeval tv;
+  tv.tv_sec = static_cast<time_t>(targetMs / 1000);
+  tv.tv_usec = static_cast<suseconds_t>((targetMs % 1000) * 1000);
+  settimeofday(&tv, nullptr);
+  steps++;
+}
@@ -0,0 +1,130 @@
+#include "TimeScrub.h"
+#include <sys/time.h>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include "HorizonStore.h"
+#include "PowerManager.h"
+
+namespace {
+// Presses shorter than this are taps.
+constexpr unsigned long kTapMs = 300;
+}
+
+int32_t TimeScrub::offsetSeconds = 0;
+time_t TimeScrub::renderedAt = 0;
+bool TimeScrub::dirty = false;
+char TimeScrub::line[16];
+uint8_t TimeScrub::lineLength = 0;
+bool TimeScrub::held = false;
+unsigned long TimeScrub::holdStartMs = 0;
+unsigned long TimeScrub::lastStepMs = 0;
+
+void TimeScrub::begin() {
+#if SCRUB_BUTTON_PIN >= 0
+  pinMode(SCRUB_BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(SCRUB_BUTTON_PIN), onButton, CHANGE);
+#endif
+}
+
+// Only wakes the loop; poll() reads the pin.
+void IRAM_ATTR TimeScrub::onButton() {
+  PowerManager::wakeFromISR();
+}
+
+void TimeScrub::poll() {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c == '\r' || c == '\n') {
+      if (lineLength == 0) continue;
+      line[lineLength] = '\0';
+      lineLength = 0;
+      if (!applyCommand(line)) Serial.printf("scrub: unknown command '%s'\n", line);
+    } else if (lineLength < sizeof(line) - 1) {
+      line[lineLength++] = static_cast<char>(c);
+    }
+  }
+
+#if SCRUB_BUTTON_PIN >= 0
+  bool pressed = digitalRead(SCRUB_BUTTON_PIN) == LOW;
+  unsigned long nowMs = millis();
+  if (pressed && !held) {
+    held = true;
+    holdStartMs = lastStepMs = nowMs;
+  } else if (pressed) {
+    // Whole preview seconds only; the remainder carries to the next frame.
+    int32_t step = static_cast<int32_t>((nowMs - lastStepMs) * SCRUB_RATE / 1000);
+    if (step > 0) {
+      lastStepMs += static_cast<unsigned long>(step) * 1000 / SCRUB_RATE;
+      setOffset(offsetSeconds + step);
+    }
+  } else if (held) {
+    held = false;
+    if (nowMs - holdStartMs < kTapMs) setOffset(0);
+  }
+#endif
+}
+
+bool TimeScrub::handleMessage(const char* payload, size_t length) {
+  static const char kPrefix[] = "{\"scrub\":";
+  const size_t prefixLength = sizeof(kPrefix) - 1;
+  if (length <= prefixLength || memcmp(payload, kPrefix, prefixLength) != 0) return false;
+  setOffset(static_cast<int32_t>(strtol(payload + prefixLength, nullptr, 10)));
+  return true;
+}
+
+// "+N" and "-N" move relative to the current offset, a bare number sets it.
+bool TimeScrub::applyCommand(const char* text) {
+  if (strcasecmp(text, "live") == 0) {
+    setOffset(0);
+    return true;
+  }
+  char* end = nullptr;
+  long seconds = strtol(text, &end, 10);
+  if (end == text) return false;
+  if (*end == 'm' || *end == 'M') {
+    seconds *= 60;
+    end++;
+  }
+  if (*end != '\0') return false;
+  bool relative = text[0] == '+' || text[0] == '-';
+  setOffset(static_cast<int32_t>(relative ? offsetSeconds + seconds : seconds));
+  Serial.printf("scrub: now+%lds\n", static_cast<long>(offsetSeconds));
+  return true;
+}
+
+void TimeScrub::setOffset(int32_t seconds) {
+  if (seconds < 0) seconds = 0;
+  if (seconds > HORIZON_SECONDS) seconds = HORIZON_SECONDS;
+  if (seconds == offsetSeconds) return;
+  offsetSeconds = seconds;
+  dirty = true;
+  PowerManager::wake();
+}
+
+int32_t TimeScrub::offset() {
+  return offsetSeconds;
+}
+
+time_t TimeScrub::previewTime() {
+  return offsetSeconds ? time(nullptr) + offsetSeconds : 0;
+}
+
+// The preview moves with the clock, so it also needs a frame each second.
+bool TimeScrub::needsRender() {
+  return dirty || (offsetSeconds && previewTime() != renderedAt);
+}
+
+void TimeScrub::markRendered(time_t at) {
+  renderedAt = at;
+  dirty = false;
+}
+
+unsigned long TimeScrub::msUntilNextStep() {
+  if (held) return SCRUB_FRAME_MS;
+  if (!offsetSeconds) return ULONG_MAX;
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return 1000 - tv.tv_usec / 1000;
+}
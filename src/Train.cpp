@@ -1,12 +1,18 @@
 #include "Train.h"
 #include <cmath>
+#include "SubwayColors.h"
 
-Train::Train() : routeId(""), arrivalTime(0) {}
+Train::Train() : route(SubwayColorMap::kUnknownRoute), arrivalTime(0), arrived(false), feed(0), direction(Promoted) {}
 
-Train::Train(const std::string& routeId, time_t arrivalTime)
-    : routeId(routeId), arrivalTime(arrivalTime) {}
+Train::Train(uint8_t route, time_t arrivalTime, uint8_t feed, Direction direction)
+    : route(route), arrivalTime(arrivalTime), arrived(false), feed(feed), direction(direction) {}
 
 bool Train::atStation(time_t currentTime) const {
     return std::difftime(currentTime, arrivalTime) >= 0 &&
            std::difftime(currentTime, arrivalTime) <= arrivalWindowSeconds;
+}
+
+// First second at which the train is no longer shown at the station.
+time_t Train::departureTime() const {
+    return arrivalTime + arrivalWindowSeconds + 1;
 }
\ No newline at end of file
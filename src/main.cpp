@@ -2,7 +2,7 @@
 #include <WiFi.h>
 #include <time.h>
 #include "WifiCredentials.h"
-#include "GeneratedStationMap.h"
+#include "StationMap.h"
 #include "TimeManager.h"
 #include "NetworkManager.h"
 #include "Station.h"
@@ -10,6 +10,17 @@
 #include "SubwayColors.h"
 #include "LEDManager.h"
 #include "MTAManager.h"
+#include "PowerManager.h"
+#include "StationMapImage.h"
+#include "Metrics.h"
+#include "ArrivalHistory.h"
+#include "DisplayMode.h"
+#include "ServiceFrequency.h"
+#include "FlightRecorder.h"
+#include "AllocTracker.h"
+#include "HorizonStore.h"
+#include "MemoryPolicy.h"
+#include "TimeScrub.h"
 
 #ifdef HEAPDEBUG
 #include "HeapDebug.h"
@@ -19,33 +30,78 @@ NetworkManager net(WIFI_SSID, WIFI_PASSWORD, SERVER_HOST, SERVER_PORT);
 
 void setup() {
   Serial.begin(115200);
+  FlightRecorder::begin();
+  AllocTracker::begin();
+  MemoryPolicy::begin();
   pinMode(LED_BUILTIN, OUTPUT);
+  if (!StationMapImage::load()) StationMap::useGenerated();
+  HorizonStore::begin();
+  MtaManager::begin();
   net.initializeWifi();
   delay(200);
   net.initializeWebsocket();
   LEDManager::initializeLEDs();
   TimeManager::initializeTime();
+  PowerManager::initialize();
+  Metrics::begin();
+  ArrivalHistory::begin();
+  DisplayMode::begin();
+  TimeScrub::begin();
   delay(3000);
 }
 
 void loop() {
+  unsigned long loopStart = micros();
+  AllocTracker::enter(AllocTracker::Network);
   net.poll(); 
+  TimeManager::poll();
   
-  if (net.checkWifiConnection())
-    net.checkWebsocketConnection();
+  bool wifiConnected = net.checkWifiConnection();
+  bool websocketConnected = wifiConnected && net.checkWebsocketConnection();
+  LEDManager::setConnectionStatus(wifiConnected, websocketConnected);
+  AllocTracker::enter(AllocTracker::Diagnostics);
+  Metrics::poll();
 
-  MtaManager::purgeExpiredTrains();
-  MtaManager::checkArrivals();
+  AllocTracker::enter(AllocTracker::Arrivals);
+  TimeScrub::poll();
+  if (MtaManager::isRefreshDue()) {
+    MtaManager::purgeExpiredTrains();
+    MtaManager::checkArrivals();
+  } else if (DisplayMode::needsRender()) {
+    MtaManager::renderArrivals();
+  }
 
-  if (!MtaManager::hasAnyTrainData())
+  unsigned long idleMs = min(MtaManager::msUntilNextChange(), DisplayMode::msUntilNextCycleStep());
+  if (DisplayMode::view() == DisplayMode::Heatmap) {
+    idleMs = min(idleMs, ServiceFrequency::msUntilNextBucket());
+  }
+  idleMs = min(idleMs, TimeScrub::msUntilNextStep());
+  if (!MtaManager::hasAnyTrainData()) {
     LEDManager::awaitingDataSequence();
+    idleMs = min(idleMs, LEDManager::msUntilNextAwaitingStep());
+  } else {
+    LEDManager::clearAwaitingSequence();
+  }
 
+  AllocTracker::enter(AllocTracker::Render);
   LEDManager::show();
+  AllocTracker::enter(AllocTracker::Network);
+  net.sendMirrorFrame();
+  AllocTracker::enter(AllocTracker::Other);
   EVERY_N_SECONDS(1) { digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN)); }
   EVERY_N_SECONDS(60) { TimeManager::printCurrentTime(); }
+  EVERY_N_SECONDS(60) { PowerManager::printPowerUsage(); }
+  EVERY_N_SECONDS(10) {
+    FlightRecorder::log(FlightRecorder::Heap, ESP.getMaxAllocHeap() / 1024, ESP.getFreeHeap());
+  }
 
 #ifdef HEAPDEBUG
+  AllocTracker::checkSteadyState();
   EVERY_N_SECONDS(60) { HeapDebug::printHeapUsage(); }
 #endif
 
+  uint32_t loopUs = micros() - loopStart;
+  Metrics::loopTime.record(loopUs);
+  FlightRecorder::recordLoop(loopUs);
+  PowerManager::idleFor(idleMs);
 }
\ No newline at end of file
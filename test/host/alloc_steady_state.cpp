@@ -0,0 +1,133 @@
+// Runs the main loop's phases on the host under AllocTracker and fails if
+// the arrivals or render phases allocate once running, or if parsing still
+// allocates once the train lists are warm. Feeds station
+// updates both as JSON payloads and through MtaManager::applyStationUpdate(),
+// and walks the arrivals view, the heatmap and a scrub preview so every
+// render path is covered.
+//
+// Build and run with test/host/run.sh.
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <thread>
+#include "AllocTracker.h"
+#include "ArrivalHistory.h"
+#include "DisplayMode.h"
+#include "HostFirmware.h"
+#include "LEDManager.h"
+#include "MTAManager.h"
+#include "Metrics.h"
+#include "StationMap.h"
+#include "SubwayColors.h"
+#include "TimeScrub.h"
+
+namespace {
+// Rounds between updates: long enough (with kRoundMs) for trains stored just
+// past the look-ahead to be promoted from the horizon before the next one.
+constexpr int kUpdateEvery = 48;
+constexpr int kUpdates = 12;
+constexpr int kRounds = kUpdates * kUpdateEvery;
+// Updates after which parsing must stop allocating: train lists have reached
+// their capacity and the receive buffer its largest payload.
+constexpr int kWarmUpdates = 4;
+constexpr int kRoundMs = 25;
+constexpr size_t kStations = 120;
+const char* const kRoutes[] = {"A", "C", "E", "1", "2", "3", "N", "Q", "R", "W", "L", "G"};
+
+std::string isoTime(time_t t) {
+  char buf[32];
+  strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", gmtime(&t));
+  return buf;
+}
+
+// Arrivals that shift from round to round, so trains enter and leave their
+// windows, get replaced, promoted from the horizon and purged.
+std::string payload(time_t now, int round) {
+  std::string out = "{\"msg_id\":" + std::to_string(round + 1) + ",\"data\":[";
+  for (size_t i = 0; i < kStations && i < StationMap::stations.size(); ++i) {
+    if (i) out += ',';
+    out += "{\"id\":\"";
+    out += StationMap::stations[i].id;
+    out += "\"";
+    for (const char* dir : {"N", "S"}) {
+      out += ",\"";
+      out += dir;
+      out += "\":[";
+      for (int k = 0; k < 6; ++k) {
+        time_t arrival = now - 20 + (static_cast<time_t>(i) * 7 + k * 240 + round * 3) % 1500;
+        if (k) out += ',';
+        out += "{\"route\":\"";
+        out += kRoutes[(i + k) % (sizeof(kRoutes) / sizeof(kRoutes[0]))];
+        out += "\",\"time\":\"" + isoTime(arrival) + "\"}";
+      }
+      out += ']';
+    }
+    out += '}';
+  }
+  return out + "]}";
+}
+
+void applyDirect(time_t now, int round) {
+  AllocTracker::Scope scope(AllocTracker::Parse);
+  for (size_t i = kStations; i < 2 * kStations && i < StationMap::stations.size(); ++i) {
+    MtaManager::StationUpdate update;
+    update.feed = static_cast<uint8_t>(round / kUpdateEvery % 2);  // two feeds' horizon runs
+    update.directions = 1U << Train::North | 1U << Train::South;
+    for (int k = 0; k < 8; ++k) {
+      time_t arrival = k == 0 ? now + MtaManager::kLookAheadSeconds + 1
+                              : now - 20 + (static_cast<time_t>(i) * 11 + k * 200 + round * 5) % 1600;
+      update.add(k & 1 ? Train::South : Train::North, static_cast<uint8_t>((i + k) % SubwayColorMap::kRouteCount),
+                 arrival);
+    }
+    time_t admitAt;
+    MtaManager::applyStationUpdate(StationMap::stations[i], update, now, &admitAt);
+  }
+}
+
+uint32_t steadyStateAllocations() {
+  return AllocTracker::allocations(AllocTracker::Arrivals) + AllocTracker::allocations(AllocTracker::Render);
+}
+}
+
+int main() {
+  hostshim::setupFirmware();
+
+  uint32_t baseline = 0;
+  uint32_t parseBaseline = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    time_t now = time(nullptr);
+    if (round == kWarmUpdates * kUpdateEvery) parseBaseline = AllocTracker::allocations(AllocTracker::Parse);
+    if (round % kUpdateEvery == 0) {
+      std::string message = payload(now, round);
+      hostshim::deliver(message.data(), message.size());
+      applyDirect(now, round);
+    }
+    if (round == kRounds / 3) DisplayMode::setView(DisplayMode::Heatmap);
+    if (round == kRounds / 2) {
+      DisplayMode::setView(DisplayMode::Arrivals);
+      TimeScrub::setOffset(600);
+    }
+    if (round == 2 * kRounds / 3) TimeScrub::setOffset(0);
+
+    hostshim::runArrivals();
+    AllocTracker::enter(AllocTracker::Render);
+    LEDManager::show();
+    AllocTracker::enter(AllocTracker::Other);
+
+    // As in loop(): the first frame may allocate (driver setup); after that
+    // checkSteadyState() asserts on the host.
+    AllocTracker::checkSteadyState();
+    if (round == 0) baseline = steadyStateAllocations();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kRoundMs));
+  }
+
+  uint32_t extra = steadyStateAllocations() - baseline;
+  uint32_t parseExtra = AllocTracker::allocations(AllocTracker::Parse) - parseBaseline;
+  printf("alloc_steady_state: %d rounds, %u trains added, %u promoted, %u arrivals logged; "
+         "parse made %u allocations, %u after %d updates; arrivals/render %u after the first frame\n",
+         kRounds, Metrics::trainsAdded, Metrics::trainsPromoted, ArrivalHistory::eventCount(),
+         AllocTracker::allocations(AllocTracker::Parse), parseExtra, kWarmUpdates, extra);
+  return extra == 0 && parseExtra == 0 ? 0 : 1;
+}
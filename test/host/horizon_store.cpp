@@ -0,0 +1,226 @@
+// Checks HorizonStore on the compiled-in station map: promotion timing,
+// separate runs per feed, relocation of a run that outgrows its space,
+// compaction when the pool end is reached, and rebasing forward and back
+// across clock steps.
+//
+// Build and run with test/host/run.sh.
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include "HorizonStore.h"
+#include "MemoryPolicy.h"
+#include "Station.h"
+#include "StationMap.h"
+
+namespace {
+using Entries = std::vector<std::pair<time_t, uint8_t>>;
+// (arrival, route, feed) as promote() hands them out.
+struct Promoted {
+  time_t arrival;
+  uint8_t route;
+  uint8_t feed;
+  bool operator==(const Promoted& o) const { return arrival == o.arrival && route == o.route && feed == o.feed; }
+};
+
+int failures = 0;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                       \
+    }                                                                   \
+  } while (0)
+
+const HorizonSlot& slotOf(size_t station, uint8_t feed = 0) {
+  return HorizonStore::slot(station, feed);
+}
+
+// Everything stored for one feed's run, promoted or not.
+Entries contents(size_t station, uint8_t feed = 0) {
+  Entries out;
+  HorizonStore::forEach(station, feed, [&out](uint8_t route, time_t arrival) { out.emplace_back(arrival, route); });
+  return out;
+}
+
+// Replaces a station's feed-0 run with n trains a minute apart from first.
+Entries store(size_t station, time_t first, int n, time_t liveUntil) {
+  HorizonStore::Batch batch;
+  Entries expected;
+  for (int k = 0; k < n; ++k) {
+    uint8_t route = static_cast<uint8_t>((station + k) % 24);
+    batch.add(first + 60 * k, route);
+    expected.emplace_back(first + 60 * k, route);
+  }
+  HorizonStore::replace(station, 0, batch, liveUntil);
+  return expected;
+}
+
+void promotionTiming(time_t now) {
+  HorizonStore::Batch batch;
+  batch.add(now + 900, 3);
+  batch.add(now + 60, 1);
+  batch.add(now + 400, 2);
+  HorizonStore::replace(0, 0, batch, now + 300);
+  CHECK(slotOf(0).count == 3);
+  CHECK(HorizonStore::pendingCount(0) == 2);  // now + 60 went into the live list
+  CHECK(HorizonStore::nextPending(0) == now + 400);
+
+  std::vector<Promoted> promoted;
+  auto collect = [&promoted](uint8_t route, time_t arrival, uint8_t feed) {
+    promoted.push_back({arrival, route, feed});
+  };
+  HorizonStore::promote(0, now + 399, collect);
+  CHECK(promoted.empty());
+  HorizonStore::promote(0, now + 400, collect);
+  CHECK(promoted == std::vector<Promoted>({{now + 400, 2, 0}}));
+  CHECK(HorizonStore::nextPending(0) == now + 900);
+  HorizonStore::promote(0, now + 400, collect);
+  CHECK(promoted.size() == 1);
+
+  CHECK(HorizonStore::routesAt(0, now + 410, 30) == 1U << 2);
+  CHECK(HorizonStore::routesAt(0, now + 500, 30) == 0);
+}
+
+// A record from one feed replaces only that feed's run: the other feed's
+// queued trains survive and are promoted under their own feed.
+void separateFeeds(time_t now) {
+  const size_t station = 4;
+  HorizonStore::Batch a;
+  a.add(now + 600, 5);
+  a.add(now + 1200, 6);
+  HorizonStore::replace(station, 0, a, now + 300);
+  HorizonStore::Batch b;
+  b.add(now + 500, 7);
+  HorizonStore::replace(station, 3, b, now + 300);
+
+  // Feed 3 updates again with nothing beyond the look-ahead.
+  HorizonStore::Batch empty;
+  HorizonStore::replace(station, 3, empty, now + 300);
+  CHECK(contents(station, 0) == Entries({{now + 600, 5}, {now + 1200, 6}}));
+  CHECK(contents(station, 3).empty());
+  CHECK(HorizonStore::holds(station));
+
+  HorizonStore::Batch again;
+  again.add(now + 500, 7);
+  again.add(now + 700, 8);
+  HorizonStore::replace(station, 3, again, now + 300);
+  CHECK(HorizonStore::pendingCount(station) == 4);
+  CHECK(HorizonStore::nextPending(station) == now + 500);
+  CHECK(HorizonStore::routesAt(station, now + 610, 30) == 1U << 5);
+
+  std::vector<Promoted> promoted;
+  HorizonStore::promote(station, now + 700, [&promoted](uint8_t route, time_t arrival, uint8_t feed) {
+    promoted.push_back({arrival, route, feed});
+  });
+  CHECK(promoted == std::vector<Promoted>({{now + 600, 5, 0}, {now + 500, 7, 3}, {now + 700, 8, 3}}));
+  CHECK(HorizonStore::nextPending(station) == now + 1200);
+
+  // Both feeds empty: the station holds nothing.
+  HorizonStore::replace(station, 0, empty, now + 300);
+  HorizonStore::replace(station, 3, empty, now + 300);
+  CHECK(!HorizonStore::holds(station));
+  CHECK(HorizonStore::nextPending(station) == 0);
+}
+
+void relocation(time_t now) {
+  Entries first = store(1, now + 10, 3, now);
+  Entries second = store(2, now + 20, 3, now);
+  uint16_t start = slotOf(1).start;
+  CHECK(slotOf(2).start == start + 3);
+
+  // Outgrows its three entries: moves past station 2.
+  first = store(1, now + 30, 10, now);
+  CHECK(slotOf(1).start > slotOf(2).start);
+  CHECK(contents(1) == first);
+  CHECK(contents(2) == second);
+
+  // Shrinks in place.
+  start = slotOf(1).start;
+  first = store(1, now + 40, 4, now);
+  CHECK(slotOf(1).start == start);
+  CHECK(contents(1) == first);
+}
+
+// Grows every station's run in turn until the pool end is reached several
+// times over. Live entries stay under HORIZON_CAPACITY, so compaction must
+// always find room and nothing is dropped.
+void compaction(time_t now) {
+  const size_t stations = StationMap::stations.size();
+  const int maxRun = static_cast<int>(HORIZON_CAPACITY / stations) - 1;
+  std::vector<Entries> expected(stations);
+
+  uint32_t droppedBefore = HorizonStore::dropped();
+  for (int round = 0; round < 8; ++round) {
+    for (size_t i = 0; i < stations; ++i) {
+      int n = static_cast<int>((round * 7 + i) % maxRun) + 1;
+      expected[i] = store(i, now + 5 + static_cast<time_t>(i % 50), n, now);
+    }
+  }
+  CHECK(HorizonStore::dropped() == droppedBefore);
+
+  size_t live = 0;
+  bool intact = true;
+  for (size_t i = 0; i < stations; ++i) {
+    intact = intact && contents(i) == expected[i];
+    live += slotOf(i).count;
+  }
+  CHECK(intact);
+  CHECK(HorizonStore::used() == live);
+}
+
+// Stored arrivals keep their absolute times across rebases; only those
+// behind the new epoch (forward) or out of offset range (back) are lost.
+void rebase(time_t now) {
+  Entries a = store(3, now + 100, 20, now);
+  HorizonStore::advance(now + 600);  // well past the rebase threshold
+  Entries kept;
+  for (const auto& e : a) {
+    if (e.first >= now + 600 - 31) kept.push_back(e);
+  }
+  CHECK(contents(3) == kept);
+
+  // A step back two minutes, as an NTP correction after a server-time sync
+  // might make: nothing is lost.
+  HorizonStore::advance(now + 480);
+  CHECK(contents(3) == kept);
+  CHECK(HorizonStore::routesAt(3, kept.back().first, 0) == 1U << kept.back().second);
+
+  // A long step back drops only what no longer fits the offset bits, all
+  // of it beyond the horizon from the new time.
+  const time_t back = now - 1200;
+  uint32_t droppedBefore = HorizonStore::dropped();
+  HorizonStore::advance(back);
+  Entries after = contents(3);
+  CHECK(!after.empty());
+  CHECK(after.size() <= kept.size());
+  CHECK(std::equal(after.begin(), after.end(), kept.begin()));
+  for (size_t i = after.size(); i < kept.size(); ++i) CHECK(kept[i].first - back > HORIZON_SECONDS);
+  // Other stations' runs from compaction() lose their far entries too.
+  CHECK(HorizonStore::dropped() - droppedBefore >= kept.size() - after.size());
+
+  // A jump beyond the offset range clears the store.
+  HorizonStore::advance(now + 7200);
+  CHECK(contents(3).empty());
+  CHECK(HorizonStore::used() == 0);
+}
+}
+
+int main() {
+  MemoryPolicy::begin();
+  StationMap::useGenerated();
+  HorizonStore::begin();
+
+  const time_t now = 1700000000;
+  HorizonStore::advance(now);
+  promotionTiming(now);
+  separateFeeds(now);
+  relocation(now);
+  compaction(now);
+  rebase(now);
+
+  printf("horizon_store: %d failed checks\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+// Checks where MemoryPolicy puts the firmware's large buffers, using the
+// host shim's simulated heaps: the parse document, the horizon pool and the
+// arrival history go to PSRAM, the station table stays internal, and
+// without PSRAM external requests fall back and are counted.
+//
+// Build and run with test/host/run.sh.
+
+#include <cstdio>
+#include "ArrivalHistory.h"
+#include "HorizonStore.h"
+#include "MTAManager.h"
+#include "MemoryPolicy.h"
+#include "StationMap.h"
+
+namespace {
+int failures = 0;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                       \
+    }                                                                   \
+  } while (0)
+
+constexpr size_t kInternalBudget = 320 * 1024;
+constexpr size_t kExternalBudget = 8 * 1024 * 1024;
+
+// Bytes a begin() call took from each tier.
+struct Usage {
+  size_t internal;
+  size_t external;
+};
+
+template <typename F>
+Usage usageOf(F&& begin) {
+  size_t internal = MemoryPolicy::usedBytes(MemoryPolicy::Internal);
+  size_t external = MemoryPolicy::usedBytes(MemoryPolicy::External);
+  begin();
+  return {MemoryPolicy::usedBytes(MemoryPolicy::Internal) - internal,
+          MemoryPolicy::usedBytes(MemoryPolicy::External) - external};
+}
+
+// The firmware's setup() order, on a board with PSRAM.
+void withPsram() {
+  MemoryPolicy::simulate(kInternalBudget, kExternalBudget);
+  MemoryPolicy::begin();
+  CHECK(MemoryPolicy::hasExternal());
+
+  Usage stations = usageOf([] { StationMap::useGenerated(); });
+  CHECK(stations.internal >= StationMap::stations.size() * sizeof(Station));
+  CHECK(stations.external == 0);
+  CHECK(MemoryPolicy::tierOf(StationMap::stations.data()) == MemoryPolicy::Internal);
+
+  Usage horizon = usageOf([] { HorizonStore::begin(); });
+  // Entry pool plus the per-(station, feed) slot table.
+  CHECK(horizon.external == HORIZON_CAPACITY * sizeof(uint16_t) +
+                                StationMap::stations.size() * HorizonStore::kMaxFeeds * sizeof(HorizonSlot));
+  CHECK(horizon.internal == 0);
+
+  // BasicJsonDocument<SpiRamAllocator> allocates its pool up front.
+  Usage document = usageOf([] { MtaManager::begin(); });
+  CHECK(document.external >= MTA_JSON_DOC_BYTES);
+  CHECK(document.internal == 0);
+
+  Usage history = usageOf([] { ArrivalHistory::begin(); });
+  CHECK(history.external == HISTORY_PSRAM_BYTES);
+  CHECK(history.internal == 0);
+
+  CHECK(MemoryPolicy::fallbacks() == 0);
+}
+
+// No PSRAM: the same requests land in internal RAM and are counted, and a
+// request that fits nowhere fails instead of overrunning the budget.
+void withoutPsram() {
+  MemoryPolicy::simulate(kInternalBudget, 0);
+  CHECK(!MemoryPolicy::hasExternal());
+  CHECK(MemoryPolicy::freeBytes(MemoryPolicy::External) == 0);
+
+  const size_t internalBefore = MemoryPolicy::usedBytes(MemoryPolicy::Internal);
+  void* pool = MemoryPolicy::allocate(HORIZON_CAPACITY * sizeof(uint16_t), MemoryPolicy::External);
+  CHECK(pool != nullptr);
+  CHECK(pool && MemoryPolicy::tierOf(pool) == MemoryPolicy::Internal);
+  CHECK(MemoryPolicy::fallbacks() == 1);
+  CHECK(MemoryPolicy::usedBytes(MemoryPolicy::Internal) - internalBefore == HORIZON_CAPACITY * sizeof(uint16_t));
+
+  void* tooBig = MemoryPolicy::allocate(kInternalBudget, MemoryPolicy::External);
+  CHECK(tooBig == nullptr);
+  CHECK(MemoryPolicy::fallbacks() == 1);
+
+  MemoryPolicy::release(pool);
+  CHECK(MemoryPolicy::usedBytes(MemoryPolicy::Internal) == internalBefore);
+}
+}
+
+int main() {
+  withPsram();
+  withoutPsram();
+  printf("memory_policy: %d failed checks\n", failures);
+  return failures == 0 ? 0 : 1;
+}
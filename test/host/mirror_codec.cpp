@@ -0,0 +1,183 @@
+// Round-trips MirrorCodec frames: key frames, palette and RGB literals, the
+// alternating worst case against maxEncodedBytes(), and a long chain of
+// random diffs decoded the way the feedsim viewer follows a stream.
+// Truncated frames must be rejected without reading past the end (ASan).
+//
+// Build and run with test/host/run.sh.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "MirrorCodec.h"
+
+namespace {
+using Frame = std::vector<uint8_t>;
+
+int failures = 0;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                       \
+    }                                                                   \
+  } while (0)
+
+constexpr size_t kPixels = 500;
+constexpr int kFuzzFrames = 200000;
+
+// xorshift32: cheap enough to draw per pixel for every fuzzed frame.
+uint32_t rngState = 12345;
+uint32_t rng() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+void setPixel(Frame& f, size_t i, uint32_t rgb) {
+  f[i * 3] = static_cast<uint8_t>(rgb >> 16);
+  f[i * 3 + 1] = static_cast<uint8_t>(rgb >> 8);
+  f[i * 3 + 2] = static_cast<uint8_t>(rgb);
+}
+
+// A colour from a set of `colours` (all 2^24 if 0).
+uint32_t colourFrom(size_t colours) {
+  return colours ? static_cast<uint32_t>(rng() % colours) * 0x010203u + 1 : rng() & 0xFFFFFF;
+}
+
+// Encodes cur against prev, decodes the result over shown and checks that
+// shown now equals cur. Returns the encoded length.
+size_t roundTrip(const Frame& cur, const Frame* prev, Frame& shown, uint16_t seq, uint8_t* flagsOut = nullptr) {
+  const size_t pixels = cur.size() / 3;
+  std::vector<uint8_t> out(MirrorCodec::maxEncodedBytes(pixels));
+  size_t length = MirrorCodec::encode(cur.data(), prev ? prev->data() : nullptr, pixels, seq, out.data());
+  CHECK(length <= out.size());
+  if (length == 0) {
+    CHECK(prev && *prev == cur);
+    return 0;
+  }
+  CHECK(MirrorCodec::framePixels(out.data(), length) == pixels);
+  uint8_t flags = 0;
+  uint16_t decodedSeq = 0;
+  CHECK(MirrorCodec::decode(out.data(), length, shown.data(), pixels, &flags, &decodedSeq));
+  CHECK(decodedSeq == seq);
+  CHECK(((flags & MirrorCodec::kKeyFrame) != 0) == (prev == nullptr));
+  CHECK(shown == cur);
+  if (flagsOut) *flagsOut = flags;
+  return length;
+}
+
+void keyFrames() {
+  Frame black(kPixels * 3, 0);
+  Frame shown(kPixels * 3, 0xAA);  // stale content a key frame must clear
+  CHECK(roundTrip(black, nullptr, shown, 1) == MirrorCodec::kHeaderBytes);
+
+  Frame cur(kPixels * 3, 0);
+  for (size_t i = 0; i < kPixels; ++i) setPixel(cur, i, colourFrom(0));
+  std::fill(shown.begin(), shown.end(), 0x55);
+  roundTrip(cur, nullptr, shown, 2);
+
+  // Unchanged against prev: nothing to send.
+  uint8_t out[MirrorCodec::maxEncodedBytes(kPixels)];
+  CHECK(MirrorCodec::encode(cur.data(), cur.data(), kPixels, 3, out) == 0);
+}
+
+// Palette mode is used while the changed pixels have at most kMaxPalette
+// colours, and RGB literals past that.
+void paletteMode() {
+  Frame prev(kPixels * 3, 0);
+  for (size_t colours : {size_t(1), size_t(8), MirrorCodec::kMaxPalette, MirrorCodec::kMaxPalette + 1}) {
+    Frame cur(kPixels * 3, 0);
+    for (size_t i = 0; i < kPixels; ++i) setPixel(cur, i, static_cast<uint32_t>(i % colours) * 0x010203u + 1);
+    Frame shown = prev;
+    uint8_t flags = 0;
+    size_t length = roundTrip(cur, &prev, shown, 7, &flags);
+    const bool palette = (flags & MirrorCodec::kPalette) != 0;
+    CHECK(palette == (colours <= MirrorCodec::kMaxPalette));
+    if (palette) CHECK(length < kPixels * 3);
+  }
+}
+
+// Every other pixel changed is the bound maxEncodedBytes() is sized for;
+// check it with and without the palette and on strips long enough for
+// multi-byte skip counts.
+void alternatingWorstCase() {
+  for (size_t pixels : {size_t(1), size_t(2), size_t(127), size_t(500), size_t(2000), size_t(20000)}) {
+    for (size_t colours : {size_t(0), MirrorCodec::kMaxPalette}) {
+      for (size_t phase : {size_t(0), size_t(1)}) {
+        Frame prev(pixels * 3, 0);
+        Frame cur = prev;
+        for (size_t i = phase; i < pixels; i += 2) setPixel(cur, i, colourFrom(colours));
+        Frame shown = prev;
+        roundTrip(cur, &prev, shown, 9);
+        shown.assign(pixels * 3, 0x33);
+        roundTrip(cur, nullptr, shown, 10);
+      }
+    }
+  }
+}
+
+// A stream of random diffs, each decoded on top of the last, as the viewer
+// follows a map. Densities range from a single pixel to the whole strip and
+// colour sets from one to full RGB, with a key frame every so often.
+void randomStream() {
+  static const size_t kColourSets[] = {1, 4, MirrorCodec::kMaxPalette, MirrorCodec::kMaxPalette + 1, 0};
+  Frame prev(kPixels * 3, 0);
+  Frame shown(kPixels * 3, 0);
+  uint16_t seq = 0;
+  roundTrip(prev, nullptr, shown, seq++);
+  for (int n = 0; n < kFuzzFrames; ++n) {
+    Frame cur = prev;
+    const size_t colours = kColourSets[rng() % 5];
+    const uint32_t density = rng() % 1001;  // per mille of pixels changed
+    if (density == 0) {
+      setPixel(cur, rng() % kPixels, colourFrom(colours));
+    } else {
+      // Changed pixels at random gaps averaging 1000 / density.
+      const uint32_t gap = 2000 / density;
+      for (size_t i = rng() % gap; i < kPixels; i += 1 + rng() % gap) setPixel(cur, i, colourFrom(colours));
+    }
+    if (rng() % 50 == 0) {
+      roundTrip(cur, nullptr, shown, seq++);
+    } else {
+      roundTrip(cur, &prev, shown, seq++);
+    }
+    if (failures) return;  // one broken frame breaks the rest of the chain
+    prev.swap(cur);
+  }
+}
+
+// Every strict prefix of a frame is malformed or a header alone, and none
+// may be read past; a frame for another strip length is refused.
+void truncatedFrames() {
+  Frame prev(kPixels * 3, 0);
+  Frame cur = prev;
+  for (size_t i = 0; i < kPixels; i += 3) setPixel(cur, i, colourFrom(i % 2 ? 0 : 16));
+  uint8_t out[MirrorCodec::maxEncodedBytes(kPixels)];
+  size_t length = MirrorCodec::encode(cur.data(), prev.data(), kPixels, 1, out);
+  Frame shown(kPixels * 3, 0);
+  uint8_t flags;
+  uint16_t seq;
+  for (size_t n = 0; n < MirrorCodec::kHeaderBytes; ++n) {
+    std::vector<uint8_t> prefix(out, out + n);
+    CHECK(!MirrorCodec::decode(prefix.data(), n, shown.data(), kPixels, &flags, &seq));
+  }
+  for (size_t n = MirrorCodec::kHeaderBytes; n < length; ++n) {
+    std::vector<uint8_t> prefix(out, out + n);  // exact size, so ASan sees overreads
+    MirrorCodec::decode(prefix.data(), n, shown.data(), kPixels, &flags, &seq);
+  }
+  CHECK(!MirrorCodec::decode(out, length, shown.data(), kPixels - 1, &flags, &seq));
+}
+}
+
+int main() {
+  keyFrames();
+  paletteMode();
+  alternatingWorstCase();
+  truncatedFrames();
+  randomStream();
+  printf("mirror_codec: %d failed checks\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+#!/bin/sh
+# Builds and runs the host checks in this directory against tools/hostshim.
+# ArduinoJson comes from PlatformIO's library folder (`pio pkg install`);
+# set ARDUINOJSON to use another copy.
+#
+#   test/host/run.sh              all checks
+#   test/host/run.sh horizon_store one check
+set -e
+cd "$(dirname "$0")/../.."
+ARDUINOJSON=${ARDUINOJSON:-.pio/libdeps/arduino_nano_esp32/ArduinoJson/src}
+CXX=${CXX:-g++}
+OUT=${OUT:-.pio/host-tests}
+FIRMWARE=$(ls src/*.cpp | grep -v -e main.cpp -e NetworkManager.cpp)
+mkdir -p "$OUT"
+
+if [ $# -gt 0 ]; then TESTS="$*"; else TESTS=$(cd test/host && ls *.cpp | sed 's/\.cpp$//'); fi
+failed=0
+for t in $TESTS; do
+  $CXX -std=gnu++17 -O1 -g -fsanitize=address,undefined -Iinclude -Itools/hostshim -I"$ARDUINOJSON" \
+      "test/host/$t.cpp" tools/hostshim/*.cpp $FIRMWARE -o "$OUT/$t"
+  if "$OUT/$t"; then echo "PASS $t"; else echo "FAIL $t"; failed=1; fi
+done
+exit $failed
@@ -0,0 +1,75 @@
+// Checks that a train the feed reschedules after it arrived is recorded
+// once: the next generation's entry within the arrival window inherits the
+// arrived flag and the old entry goes, while another feed's train at a
+// nearby time is still its own arrival.
+//
+// Build and run with test/host/run.sh.
+
+#include <cstdio>
+#include <ctime>
+#include "ArrivalHistory.h"
+#include "HostFirmware.h"
+#include "MTAManager.h"
+#include "StationMap.h"
+#include "SubwayColors.h"
+
+namespace {
+int failures = 0;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                       \
+    }                                                                   \
+  } while (0)
+
+void apply(Station& station, uint8_t feed, uint8_t route, time_t arrival, time_t now) {
+  MtaManager::StationUpdate update;
+  update.feed = feed;
+  update.directions = 1U << Train::North;
+  update.add(Train::North, route, arrival);
+  time_t admitAt;
+  CHECK(MtaManager::applyStationUpdate(station, update, now, &admitAt));
+}
+
+size_t countRoute(const Station& station, uint8_t route) {
+  size_t n = 0;
+  for (const Train& t : station.trains) n += t.route == route;
+  return n;
+}
+
+// Both times are in the past but inside the window, so checkArrivals()
+// would record the moved entry at once if it had lost the flag.
+void rescheduledAfterArrival() {
+  Station& station = StationMap::stations[0];
+  const uint8_t route = SubwayColorMap::routeCode("A");
+  const time_t now = time(nullptr);
+
+  apply(station, 0, route, now - 25, now);
+  uint32_t before = ArrivalHistory::eventCount();
+  MtaManager::checkArrivals();
+  CHECK(ArrivalHistory::eventCount() == before + 1);
+
+  // 12:00:00 becomes 12:00:20 in the next generation.
+  apply(station, 0, route, now - 5, now);
+  CHECK(countRoute(station, route) == 1);
+  CHECK(!station.trains.empty() && station.trains.front().arrivalTime == now - 5);
+  CHECK(!station.trains.empty() && station.trains.front().arrived);
+  MtaManager::checkArrivals();
+  CHECK(ArrivalHistory::eventCount() == before + 1);
+
+  // Another feed's train is its own arrival, even at a nearby time.
+  apply(station, 1, route, now - 10, now);
+  CHECK(countRoute(station, route) == 2);
+  MtaManager::checkArrivals();
+  CHECK(ArrivalHistory::eventCount() == before + 2);
+}
+}
+
+int main() {
+  hostshim::setupFirmware();
+  rescheduledAfterArrival();
+  printf("station_update: %d failed checks\n", failures);
+  return failures == 0 ? 0 : 1;
+}
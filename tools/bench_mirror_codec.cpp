@@ -0,0 +1,80 @@
+// Host benchmark for MirrorCodec::encode, the per-message cost FrameMirror
+// adds to the loop. The target is well under 1 ms per 500 LEDs on the
+// ESP32-S3; a desktop runs the same loops one to two orders of magnitude
+// faster, so anything near 100 us here deserves a look.
+//
+// Build and run from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/bench_mirror_codec.cpp -o bench_mirror_codec
+//   ./bench_mirror_codec
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "MirrorCodec.h"
+
+namespace {
+
+volatile size_t sink;
+
+template <typename Fn>
+double nsPerCall(Fn&& fn, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) fn(i);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void setPixel(std::vector<uint8_t>& f, size_t i, uint32_t rgb) {
+  f[i * 3] = static_cast<uint8_t>(rgb >> 16);
+  f[i * 3 + 1] = static_cast<uint8_t>(rgb >> 8);
+  f[i * 3 + 2] = static_cast<uint8_t>(rgb);
+}
+
+// Encodes cur against prev (nullptr: key frame); returns ns per encode and
+// the encoded size in *bytes.
+double timeEncode(const std::vector<uint8_t>& cur, const std::vector<uint8_t>* prev, size_t pixels, int iterations,
+                  size_t* bytes) {
+  std::vector<uint8_t> out(MirrorCodec::maxEncodedBytes(pixels));
+  double ns = nsPerCall([&](int i) {
+    *bytes = MirrorCodec::encode(cur.data(), prev ? prev->data() : nullptr, pixels, static_cast<uint16_t>(i),
+                                 out.data());
+  }, iterations);
+  sink = *bytes;
+  return ns;
+}
+
+void run(size_t pixels, int iterations) {
+  const size_t bytes = pixels * 3;
+  // Base map: every LED lit in one of 24 route colours.
+  std::vector<uint8_t> base(bytes);
+  for (size_t i = 0; i < pixels; ++i) setPixel(base, i, static_cast<uint32_t>(i % 24) * 0x0A0B0Cu);
+
+  // A typical update: a couple of dozen stations change route colour.
+  std::vector<uint8_t> typical = base;
+  for (size_t i = 7; i < pixels; i += pixels / 24) setPixel(typical, i, 0xFFFFFF);
+
+  // Worst case: every other LED changes to a colour of its own, so neither
+  // the palette nor the skip counts help.
+  std::vector<uint8_t> worst = base;
+  for (size_t i = 0; i < pixels; i += 2) setPixel(worst, i, static_cast<uint32_t>(rand()) & 0xFFFFFF);
+
+  size_t idleBytes, typicalBytes, keyBytes, worstBytes;
+  double idle = timeEncode(base, &base, pixels, iterations, &idleBytes);
+  double diff = timeEncode(typical, &base, pixels, iterations, &typicalBytes);
+  double key = timeEncode(base, nullptr, pixels, iterations, &keyBytes);
+  double bad = timeEncode(worst, &base, pixels, iterations, &worstBytes);
+
+  printf("%5zu LEDs  unchanged %7.2f us  typical %7.2f us (%zu B)  key %7.2f us (%zu B)  worst %7.2f us (%zu B)\n",
+         pixels, idle / 1000, diff / 1000, typicalBytes, key / 1000, keyBytes, bad / 1000, worstBytes);
+}
+
+}
+
+int main(int argc, char** argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+  printf("MirrorCodec::encode, %d iterations\n", iterations);
+  run(500, iterations);
+  run(2000, iterations);
+  return 0;
+}
@@ -0,0 +1,67 @@
+// Host benchmark for the heatmap's ServiceFrequency passes over the
+// compiled-in station map.
+//
+// Build and run from the repo root (needs the firmware and tools/hostshim,
+// see tools/hostshim/README.md):
+//   JSON=.pio/libdeps/arduino_nano_esp32/ArduinoJson/src
+//   FIRMWARE=$(ls src/*.cpp | grep -v -e main.cpp -e NetworkManager.cpp)
+//   g++ -std=gnu++17 -O2 -Iinclude -Itools/hostshim -I$JSON tools/bench_service_frequency.cpp tools/hostshim/*.cpp $FIRMWARE -o bench_service_frequency
+//   ./bench_service_frequency
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "ServiceFrequency.h"
+#include "StationMap.h"
+
+namespace {
+
+volatile uint32_t sink;
+
+template <typename Fn>
+double nsPerCall(Fn&& fn, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) fn(i);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+}
+
+int main(int argc, char** argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+  StationMap::useGenerated();
+  const size_t stations = StationMap::stations.size();
+
+  time_t now = 1700000000;
+  ServiceFrequency::advance(now);
+  // A busy but unsaturated window: a few arrivals per station per bucket.
+  for (int b = 0; b < HEAT_BUCKETS; ++b) {
+    for (Station& station : StationMap::stations) {
+      for (int n = rand() % 6; n > 0; --n) ServiceFrequency::record(station.frequency);
+    }
+    now += ServiceFrequency::kBucketSeconds;
+    ServiceFrequency::advance(now);
+  }
+
+  // What renderArrivals() does per station in the heatmap view.
+  double render = nsPerCall([&](int) {
+    uint32_t acc = 0;
+    for (const Station& station : StationMap::stations) {
+      uint8_t level = ServiceFrequency::level(station.frequency);
+      if (level) acc += ServiceFrequency::color(level);
+    }
+    sink = acc;
+  }, iterations);
+
+  // One bucket boundary: the oldest bucket is subtracted from every station.
+  double retire = nsPerCall([&](int) {
+    now += ServiceFrequency::kBucketSeconds;
+    ServiceFrequency::advance(now);
+  }, iterations);
+
+  printf("%zu stations, %d buckets of %u s, %d iterations\n", stations, HEAT_BUCKETS,
+         static_cast<unsigned>(ServiceFrequency::kBucketSeconds), iterations);
+  printf("level + colour pass %8.1f ns  | bucket retire %8.1f ns\n", render, retire);
+  return 0;
+}
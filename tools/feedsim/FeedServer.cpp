@@ -0,0 +1,269 @@
+#include "FeedServer.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "WebSocket.h"
+
+namespace feedsim {
+
+namespace {
+long long wallClockMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+// Puts the trace fields the firmware's LatencyTracer reads ahead of "data".
+// Generated feeds are built on the spot, so feed_ms is the build time. Every
+// broadcast is a full snapshot, so it is also a new generation.
+std::string stampTrace(const std::string& payload, uint32_t msgId, long long feedMs, long long sentMs) {
+  if (payload.empty() || payload[0] != '{') return payload;
+  char header[128];
+  snprintf(header, sizeof(header), "{\"msg_id\":%u,\"feed_ms\":%lld,\"sent_ms\":%lld,\"gen\":%u,",
+           msgId, feedMs, sentMs, msgId);
+  std::string stamped = header + payload.substr(1);
+  if (payload[1] == '}') stamped.erase(strlen(header) - 1, 1);
+  return stamped;
+}
+
+FeedServer::FeedServer(Timetable& timetable, const FeedOptions& feed, const ServerOptions& options)
+    : timetable(timetable), feed(feed), options(options), rng(std::random_device{}()) {
+  if (!options.mirrorPath.empty()) mirror = std::make_unique<MirrorViewer>(options.mirrorPath, options.mirrorWidth);
+}
+
+FeedServer::~FeedServer() {
+  for (auto& peer : peers) closePeer(*peer);
+  if (listenFd >= 0) close(listenFd);
+}
+
+bool FeedServer::listen() {
+  if (!options.replayPath.empty()) {
+    std::ifstream in(options.replayPath, std::ios::binary);
+    if (!in) {
+      fprintf(stderr, "cannot read replay payload %s\n", options.replayPath.c_str());
+      return false;
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    replayPayload = content.str();
+  }
+
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd < 0) return false;
+  int yes = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  fcntl(listenFd, F_SETFL, O_NONBLOCK);
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(options.port);
+  if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      ::listen(listenFd, 512) < 0) {
+    perror("feed server bind/listen");
+    return false;
+  }
+  return true;
+}
+
+void FeedServer::collectPollFds(std::vector<pollfd>& fds) {
+  fds.push_back({listenFd, POLLIN, 0});
+  for (auto& peer : peers) {
+    short events = POLLIN;
+    if (!peer->out.empty()) events |= POLLOUT;
+    fds.push_back({peer->fd, events, 0});
+  }
+}
+
+void FeedServer::handlePoll(const std::vector<pollfd>& fds, size_t first, long nowMs) {
+  if (fds[first].revents & POLLIN) accept();
+
+  // Peers accepted above are not in fds yet; only walk the ones that were.
+  size_t polled = std::min(peers.size(), fds.size() - first - 1);
+  for (size_t i = 0; i < polled; ++i) {
+    Peer& peer = *peers[i];
+    short revents = fds[first + 1 + i].revents;
+    bool alive = true;
+    if (revents & (POLLERR | POLLHUP | POLLNVAL)) alive = false;
+    if (alive && (revents & POLLIN)) alive = readPeer(peer);
+    if (alive && (revents & POLLOUT)) alive = flushPeer(peer);
+    if (alive && peer.closing && peer.out.empty()) alive = false;
+    if (!alive) closePeer(peer);
+  }
+  peers.erase(std::remove_if(peers.begin(), peers.end(),
+                             [](const std::unique_ptr<Peer>& p) { return p->fd < 0; }),
+              peers.end());
+
+  if (nowMs >= nextBroadcastMs) {
+    broadcast(nowMs);
+    nextBroadcastMs = nowMs + options.intervalMs;
+  }
+}
+
+long FeedServer::nextDeadlineMs() const {
+  return nextBroadcastMs;
+}
+
+size_t FeedServer::openPeers() const {
+  return std::count_if(peers.begin(), peers.end(), [](const std::unique_ptr<Peer>& p) { return p->open; });
+}
+
+const ServerStats& FeedServer::stats() const {
+  return counters;
+}
+
+const MirrorViewer* FeedServer::mirrorViewer() const {
+  return mirror.get();
+}
+
+void FeedServer::accept() {
+  for (;;) {
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return;
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    int yes = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    auto peer = std::make_unique<Peer>();
+    peer->fd = fd;
+    peers.push_back(std::move(peer));
+    counters.connections++;
+  }
+}
+
+bool FeedServer::readPeer(Peer& peer) {
+  char buf[16384];
+  for (;;) {
+    ssize_t n = recv(peer.fd, buf, sizeof(buf), 0);
+    if (n > 0) {
+      peer.in.append(buf, n);
+      continue;
+    }
+    if (n == 0) return false;
+    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+    return false;
+  }
+
+  if (!peer.open && !handshake(peer)) return !peer.closing || !peer.out.empty();
+  if (peer.open) handleFrames(peer);
+  return true;
+}
+
+bool FeedServer::flushPeer(Peer& peer) {
+  while (!peer.out.empty()) {
+    ssize_t n = send(peer.fd, peer.out.data(), peer.out.size(), MSG_NOSIGNAL);
+    if (n > 0) {
+      peer.out.erase(0, n);
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+    return false;
+  }
+  return true;
+}
+
+bool FeedServer::handshake(Peer& peer) {
+  size_t end = peer.in.find("\r\n\r\n");
+  if (end == std::string::npos) return false;
+  std::string head = peer.in.substr(0, end + 2);
+  peer.in.erase(0, end + 4);
+
+  std::string key = headerValue(head, "Sec-WebSocket-Key");
+  if (head.compare(0, 8, "GET /ws ") != 0 || key.empty()) {
+    counters.handshakeFailures++;
+    peer.out += "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    peer.closing = true;
+    return false;
+  }
+
+  peer.out += "HTTP/1.1 101 Switching Protocols\r\n"
+              "Upgrade: websocket\r\n"
+              "Connection: Upgrade\r\n"
+              "Sec-WebSocket-Accept: " + acceptKey(key) + "\r\n\r\n";
+  peer.open = true;
+  // New devices get the current state right away instead of waiting for the
+  // next broadcast.
+  if (!currentFrame.empty()) queue(peer, currentFrame);
+  if (mirror) {
+    static const char kMirrorOn[] = "{\"mirror\":1}";
+    queue(peer, encodeFrame(OpText, kMirrorOn, sizeof(kMirrorOn) - 1, false));
+  }
+  return true;
+}
+
+void FeedServer::handleFrames(Peer& peer) {
+  for (;;) {
+    Frame frame;
+    long used = decodeFrame(peer.in.data(), peer.in.size(), frame);
+    if (used == 0) return;
+    if (used < 0) {
+      peer.closing = true;
+      return;
+    }
+    peer.in.erase(0, used);
+    counters.framesReceived++;
+
+    if (frame.opcode == OpPing) {
+      queue(peer, encodeFrame(OpPong, frame.payload.data(), frame.payload.size(), false));
+      counters.pingsAnswered++;
+    } else if (frame.opcode == OpBinary && mirror) {
+      mirror->apply(peer.fd, frame.payload);
+    } else if (frame.opcode == OpClose) {
+      queue(peer, encodeFrame(OpClose, frame.payload.data(), frame.payload.size(), false));
+      peer.closing = true;
+      return;
+    }
+  }
+}
+
+void FeedServer::broadcast(long nowMs) {
+  (void)nowMs;
+  auto start = std::chrono::steady_clock::now();
+  long long feedMs = wallClockMs();
+  std::string payload = replayPayload.empty() ? timetable.buildPayload(feedMs / 1000, feed) : replayPayload;
+  payload = stampTrace(payload, nextMessageId++, feedMs, wallClockMs());
+  currentFrame = encodeFrame(OpText, payload.data(), payload.size(), false);
+  counters.lastBuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  counters.lastPayloadBytes = payload.size();
+
+  std::uniform_real_distribution<double> chance(0.0, 1.0);
+  for (auto& peer : peers) {
+    if (!peer->open || peer->closing) continue;
+    if (options.dropProbability > 0 && chance(rng) < options.dropProbability) {
+      counters.injectedDrops++;
+      closePeer(*peer);
+      continue;
+    }
+    if (peer->out.size() > options.maxBacklogBytes) {
+      counters.slowDrops++;
+      closePeer(*peer);
+      continue;
+    }
+    queue(*peer, currentFrame);
+    counters.messagesSent++;
+  }
+}
+
+void FeedServer::queue(Peer& peer, const std::string& frame) {
+  peer.out += frame;
+  counters.bytesSent += frame.size();
+  if (!flushPeer(peer)) closePeer(peer);
+}
+
+void FeedServer::closePeer(Peer& peer) {
+  if (mirror && peer.fd >= 0) mirror->forget(peer.fd);
+  if (peer.fd >= 0) close(peer.fd);
+  peer.fd = -1;
+  peer.open = false;
+}
+
+}
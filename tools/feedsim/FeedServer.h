@@ -0,0 +1,89 @@
+#ifndef FEEDSIM_FEEDSERVER_H
+#define FEEDSIM_FEEDSERVER_H
+
+#include <poll.h>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "MirrorViewer.h"
+#include "Timetable.h"
+
+namespace feedsim {
+
+struct ServerOptions {
+  uint16_t port = 5000;
+  long intervalMs = 10000;       // broadcast cadence, like MTAPI's CACHE_SECONDS
+  double dropProbability = 0.0;  // per peer per broadcast
+  std::string replayPath;        // send this file verbatim instead of generating
+  size_t maxBacklogBytes = 16u << 20;
+  std::string mirrorPath;        // ask maps to mirror their LEDs and draw them here
+  size_t mirrorWidth = 50;       // LEDs per row in the mirror view
+};
+
+struct ServerStats {
+  uint64_t connections = 0;
+  uint64_t handshakeFailures = 0;
+  uint64_t messagesSent = 0;
+  uint64_t bytesSent = 0;
+  uint64_t injectedDrops = 0;
+  uint64_t slowDrops = 0;
+  uint64_t pingsAnswered = 0;
+  uint64_t framesReceived = 0;
+  size_t lastPayloadBytes = 0;
+  double lastBuildMs = 0;
+};
+
+std::string stampTrace(const std::string& payload, uint32_t msgId, long long feedMs, long long sentMs);
+
+// Serves ws://<host>:<port>/ws and broadcasts one payload to every open peer
+// per interval. Single-threaded; the caller's poll() loop drives it.
+class FeedServer {
+public:
+  FeedServer(Timetable& timetable, const FeedOptions& feed, const ServerOptions& options);
+  ~FeedServer();
+
+  bool listen();
+  void collectPollFds(std::vector<pollfd>& fds);
+  void handlePoll(const std::vector<pollfd>& fds, size_t first, long nowMs);
+  long nextDeadlineMs() const;
+  size_t openPeers() const;
+  const ServerStats& stats() const;
+  const MirrorViewer* mirrorViewer() const;
+
+private:
+  struct Peer {
+    int fd = -1;
+    bool open = false;
+    bool closing = false;
+    std::string in;
+    std::string out;
+  };
+
+  void accept();
+  bool readPeer(Peer& peer);
+  bool flushPeer(Peer& peer);
+  bool handshake(Peer& peer);
+  void handleFrames(Peer& peer);
+  void broadcast(long nowMs);
+  void queue(Peer& peer, const std::string& frame);
+  void closePeer(Peer& peer);
+
+  Timetable& timetable;
+  FeedOptions feed;
+  ServerOptions options;
+  ServerStats counters;
+  int listenFd = -1;
+  std::vector<std::unique_ptr<Peer>> peers;
+  std::unique_ptr<MirrorViewer> mirror;
+  std::string currentFrame;
+  std::string replayPayload;
+  long nextBroadcastMs = 0;
+  uint32_t nextMessageId = 1;
+  std::mt19937 rng;
+};
+
+}
+
+#endif // FEEDSIM_FEEDSERVER_H
@@ -0,0 +1,101 @@
+#include "MirrorViewer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "../../include/MirrorCodec.h"
+
+namespace feedsim {
+
+namespace {
+// Each LED is drawn as a block this many pixels wide in the PPM.
+constexpr size_t kScale = 8;
+}
+
+MirrorViewer::MirrorViewer(const std::string& path, size_t width) : path(path), width(width ? width : 50) {}
+
+void MirrorViewer::apply(int peer, const std::string& payload) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(payload.data());
+  counters.bytes += payload.size();
+  Stream& stream = streams[peer];
+  bool key = payload.size() >= MirrorCodec::kHeaderBytes && (in[0] & MirrorCodec::kKeyFrame);
+  uint16_t seq = payload.size() >= MirrorCodec::kHeaderBytes ? static_cast<uint16_t>(in[1] | (in[2] << 8)) : 0;
+
+  if (key) {
+    stream.pixels.assign(MirrorCodec::framePixels(in, payload.size()) * 3, 0);
+    stream.synced = true;
+  } else if (!stream.synced) {
+    return;
+  } else if (seq != stream.nextSeq) {
+    counters.gaps++;
+    stream.synced = false;
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  uint8_t flags;
+  bool ok = MirrorCodec::decode(in, payload.size(), stream.pixels.data(), stream.pixels.size() / 3, &flags, &seq);
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  if (!ok) {
+    counters.errors++;
+    stream.synced = false;
+    return;
+  }
+  counters.decodeUsMax = std::max(counters.decodeUsMax, us);
+  counters.frames++;
+  if (key) counters.keyFrames++;
+  stream.nextSeq = static_cast<uint16_t>(seq + 1);
+  draw(stream);
+}
+
+void MirrorViewer::forget(int peer) {
+  streams.erase(peer);
+}
+
+const MirrorStats& MirrorViewer::stats() const {
+  return counters;
+}
+
+void MirrorViewer::draw(const Stream& stream) {
+  const size_t count = stream.pixels.size() / 3;
+  const size_t rows = (count + width - 1) / width;
+  const uint8_t* px = stream.pixels.data();
+
+  if (path == "-") {
+    std::string out = "\x1b[H";
+    char cell[32];
+    for (size_t r = 0; r < rows; ++r) {
+      for (size_t c = 0; c < width; ++c) {
+        size_t i = r * width + c;
+        if (i >= count) break;
+        snprintf(cell, sizeof(cell), "\x1b[38;2;%u;%u;%um██", px[i * 3], px[i * 3 + 1], px[i * 3 + 2]);
+        out += cell;
+      }
+      out += "\x1b[0m\n";
+    }
+    fwrite(out.data(), 1, out.size(), stdout);
+    fflush(stdout);
+    return;
+  }
+
+  // Written beside the target and renamed over it, so a viewer polling the
+  // file never sees half a frame.
+  std::string tmp = path + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f) return;
+  fprintf(f, "P6\n%zu %zu\n255\n", width * kScale, rows * kScale);
+  std::vector<uint8_t> line(width * kScale * 3);
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < width; ++c) {
+      size_t i = r * width + c;
+      const uint8_t black[3] = {0, 0, 0};
+      const uint8_t* rgb = i < count ? &px[i * 3] : black;
+      for (size_t k = 0; k < kScale; ++k) memcpy(&line[(c * kScale + k) * 3], rgb, 3);
+    }
+    for (size_t k = 0; k < kScale; ++k) fwrite(line.data(), 1, line.size(), f);
+  }
+  fclose(f);
+  rename(tmp.c_str(), path.c_str());
+}
+
+}
@@ -0,0 +1,49 @@
+#ifndef FEEDSIM_MIRRORVIEWER_H
+#define FEEDSIM_MIRRORVIEWER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace feedsim {
+
+struct MirrorStats {
+  uint64_t frames = 0;
+  uint64_t keyFrames = 0;
+  uint64_t bytes = 0;
+  uint64_t gaps = 0;        // sequence jumps; frames are dropped until the next key frame
+  uint64_t errors = 0;
+  double decodeUsMax = 0;
+};
+
+// Rebuilds the LED frames maps stream back with FrameMirror (binary
+// MirrorCodec messages) and shows the latest one: as a PPM image rewritten
+// in place, or drawn in the terminal with truecolor blocks when the path is
+// "-". One stream per connection; all of them are drawn to the same output.
+class MirrorViewer {
+public:
+  MirrorViewer(const std::string& path, size_t width);
+
+  void apply(int peer, const std::string& payload);
+  void forget(int peer);
+  const MirrorStats& stats() const;
+
+private:
+  struct Stream {
+    std::vector<uint8_t> pixels;
+    uint16_t nextSeq = 0;
+    bool synced = false;
+  };
+
+  void draw(const Stream& stream);
+
+  std::string path;
+  size_t width;
+  std::map<int, Stream> streams;
+  MirrorStats counters;
+};
+
+}
+
+#endif // FEEDSIM_MIRRORVIEWER_H
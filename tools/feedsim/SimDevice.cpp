@@ -0,0 +1,269 @@
+#include "SimDevice.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "HostFirmware.h"
+#include "WebSocket.h"
+
+namespace feedsim {
+
+namespace {
+constexpr long kMaxBackoffMs = 30000;
+constexpr long kPingIntervalMs = 10000;
+
+size_t countOccurrences(const std::string& haystack, const char* needle) {
+  size_t count = 0;
+  size_t length = strlen(needle);
+  for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + length)) {
+    ++count;
+  }
+  return count;
+}
+
+// Integer trace field ahead of "data", or 0 if absent.
+long long headerNumber(const std::string& payload, size_t headerEnd, const char* key) {
+  size_t pos = payload.find(key);
+  if (pos == std::string::npos || pos >= headerEnd) return 0;
+  return strtoll(payload.c_str() + pos + strlen(key), nullptr, 10);
+}
+}
+
+SimDevice::SimDevice(const DeviceOptions& options, DeviceStats& stats, uint32_t seed)
+    : options(options), stats(stats), rng(seed) {}
+
+SimDevice::~SimDevice() {
+  if (fd >= 0) close(fd);
+}
+
+void SimDevice::start(long nowMs) {
+  // Spread the initial connects so hundreds of devices don't all SYN at once.
+  nextAttemptMs = nowMs + static_cast<long>(rng() % 1000);
+}
+
+bool SimDevice::wantsPoll() const {
+  return fd >= 0;
+}
+
+pollfd SimDevice::pollFd() const {
+  short events = POLLIN;
+  if (state == Connecting || !out.empty()) events |= POLLOUT;
+  return {fd, events, 0};
+}
+
+bool SimDevice::isOpen() const {
+  return state == Open;
+}
+
+long SimDevice::nextDeadlineMs() const {
+  if (state == Idle) return nextAttemptMs;
+  if (state == Open) return lastPingMs + kPingIntervalMs;
+  return nextAttemptMs + kMaxBackoffMs;
+}
+
+void SimDevice::tick(long nowMs) {
+  if (state == Idle && nowMs >= nextAttemptMs) {
+    connect(nowMs);
+  } else if (state == Open && nowMs - lastPingMs >= kPingIntervalMs) {
+    send(encodeFrame(OpPing, "", 0, true), nowMs);
+    lastPingMs = nowMs;
+  } else if ((state == Connecting || state == Handshake) && nowMs - nextAttemptMs > kMaxBackoffMs) {
+    disconnect(nowMs);
+  }
+}
+
+void SimDevice::handlePoll(short revents, long nowMs) {
+  if (fd < 0) return;
+  if (state == Connecting && (revents & (POLLOUT | POLLERR | POLLHUP))) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+    if (error != 0) {
+      disconnect(nowMs);
+      return;
+    }
+    uint8_t nonce[16];
+    for (auto& b : nonce) b = static_cast<uint8_t>(rng());
+    key = base64Encode(nonce, sizeof(nonce));
+    state = Handshake;
+    send("GET /ws HTTP/1.1\r\n"
+         "Host: " + options.host + ":" + std::to_string(options.port) + "\r\n"
+         "Upgrade: websocket\r\n"
+         "Connection: Upgrade\r\n"
+         "Sec-WebSocket-Key: " + key + "\r\n"
+         "Sec-WebSocket-Version: 13\r\n\r\n", nowMs);
+    return;
+  }
+
+  if ((revents & POLLIN) && !readSocket()) {
+    stats.remoteCloses++;
+    disconnect(nowMs);
+    return;
+  }
+  if ((revents & POLLOUT) && !flush()) {
+    disconnect(nowMs);
+    return;
+  }
+  if (revents & (POLLERR | POLLNVAL)) {
+    disconnect(nowMs);
+    return;
+  }
+
+  if (state == Handshake) {
+    size_t end = in.find("\r\n\r\n");
+    if (end == std::string::npos) return;
+    std::string head = in.substr(0, end + 2);
+    in.erase(0, end + 4);
+    if (head.compare(0, 12, "HTTP/1.1 101") != 0 ||
+        headerValue(head, "Sec-WebSocket-Accept") != acceptKey(key)) {
+      disconnect(nowMs);
+      return;
+    }
+    state = Open;
+    stats.connects++;
+    if (everConnected) stats.reconnects++;
+    everConnected = true;
+    backoffMs = 1000;
+    lastPingMs = nowMs;
+  }
+  if (state == Open) handleFrames(nowMs);
+}
+
+void SimDevice::connect(long nowMs) {
+  stats.connectAttempts++;
+  nextAttemptMs = nowMs;
+
+  addrinfo hints = {};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  std::string port = std::to_string(options.port);
+  if (getaddrinfo(options.host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+    disconnect(nowMs);
+    return;
+  }
+
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  int rc = ::connect(fd, result->ai_addr, result->ai_addrlen);
+  freeaddrinfo(result);
+  if (rc < 0 && errno != EINPROGRESS) {
+    disconnect(nowMs);
+    return;
+  }
+  state = Connecting;
+}
+
+void SimDevice::disconnect(long nowMs) {
+  if (fd >= 0) close(fd);
+  fd = -1;
+  in.clear();
+  out.clear();
+  state = Idle;
+  nextAttemptMs = nowMs + backoffMs;
+  backoffMs = std::min(backoffMs * 2, kMaxBackoffMs);
+}
+
+bool SimDevice::readSocket() {
+  char buf[16384];
+  for (;;) {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n > 0) {
+      in.append(buf, n);
+      continue;
+    }
+    if (n == 0) return false;
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+  }
+}
+
+bool SimDevice::flush() {
+  while (!out.empty()) {
+    ssize_t n = ::send(fd, out.data(), out.size(), MSG_NOSIGNAL);
+    if (n > 0) {
+      out.erase(0, n);
+      continue;
+    }
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+  return true;
+}
+
+void SimDevice::send(const std::string& bytes, long nowMs) {
+  out += bytes;
+  if (!flush()) disconnect(nowMs);
+}
+
+void SimDevice::handleFrames(long nowMs) {
+  std::uniform_real_distribution<double> chance(0.0, 1.0);
+  for (;;) {
+    Frame frame;
+    long used = decodeFrame(in.data(), in.size(), frame);
+    if (used == 0) return;
+    if (used < 0) {
+      disconnect(nowMs);
+      return;
+    }
+    in.erase(0, used);
+
+    if (frame.opcode == OpText) {
+      inspectPayload(frame.payload);
+      if (options.dropProbability > 0 && chance(rng) < options.dropProbability) {
+        stats.injectedDrops++;
+        disconnect(nowMs);
+        return;
+      }
+    } else if (frame.opcode == OpPong) {
+      stats.pongs++;
+    } else if (frame.opcode == OpPing) {
+      send(encodeFrame(OpPong, frame.payload.data(), frame.payload.size(), true), nowMs);
+    } else if (frame.opcode == OpClose) {
+      stats.remoteCloses++;
+      disconnect(nowMs);
+      return;
+    }
+  }
+}
+
+void SimDevice::inspectPayload(const std::string& payload) {
+  // Control messages ({"mirror":1}, {"scrub":N}) are not feed payloads.
+  if (payload.compare(0, 10, "{\"mirror\":") == 0 || payload.compare(0, 9, "{\"scrub\":") == 0) return;
+  stats.messages++;
+  stats.bytes += payload.size();
+  size_t data = payload.find("\"data\":[");
+  if (payload.empty() || payload[0] != '{' || data == std::string::npos || payload.back() != '}') {
+    stats.parseErrors++;
+    return;
+  }
+
+  uint32_t msgId = static_cast<uint32_t>(headerNumber(payload, data, "\"msg_id\":"));
+  if (msgId) {
+    if (lastMessageId && msgId > lastMessageId + 1) stats.missedMessages += msgId - lastMessageId - 1;
+    lastMessageId = msgId;
+  }
+  long long sentMs = headerNumber(payload, data, "\"sent_ms\":");
+  if (sentMs) {
+    long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    double latency = static_cast<double>(std::max(0LL, nowMs - sentMs));
+    stats.latencySamples++;
+    stats.latencySumMs += latency;
+    stats.latencyMaxMs = std::max(stats.latencyMaxMs, latency);
+  }
+  stats.stations += countOccurrences(payload, "{\"id\":");
+  stats.arrivals += countOccurrences(payload, "\"route\":");
+
+  if (options.ingest) {
+    hostshim::deliver(payload.data(), payload.size());
+    hostshim::runArrivals();
+  }
+}
+
+}
@@ -0,0 +1,87 @@
+#ifndef FEEDSIM_SIMDEVICE_H
+#define FEEDSIM_SIMDEVICE_H
+
+#include <poll.h>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace feedsim {
+
+struct DeviceOptions {
+  std::string host = "127.0.0.1";
+  uint16_t port = 5000;
+  double dropProbability = 0.0;  // per received message
+  bool ingest = true;            // run payloads through the firmware's parser
+};
+
+struct DeviceStats {
+  uint64_t connectAttempts = 0;
+  uint64_t connects = 0;
+  uint64_t reconnects = 0;
+  uint64_t messages = 0;
+  uint64_t bytes = 0;
+  uint64_t stations = 0;
+  uint64_t arrivals = 0;
+  uint64_t parseErrors = 0;
+  uint64_t pongs = 0;
+  uint64_t injectedDrops = 0;
+  uint64_t remoteCloses = 0;
+  uint64_t missedMessages = 0;   // gaps in msg_id
+  uint64_t latencySamples = 0;   // sent_ms -> received
+  double latencySumMs = 0;
+  double latencyMaxMs = 0;
+};
+
+// Host stand-in for one map. Follows NetworkManager's connection policy:
+// exponential reconnect backoff from 1 s to 30 s, reset once connected, and a
+// ping every 10 s. The trace header is used to measure delivery latency and
+// lost messages. With options.ingest, received payloads also go through the
+// firmware's own MtaManager::parseData() and arrivals phase (see
+// tools/hostshim).
+//
+// The firmware keeps its state in statics, so one process holds one map.
+// Only one device may ingest; the rest are network-only, or they would feed
+// copies of each broadcast into that same map.
+class SimDevice {
+public:
+  SimDevice(const DeviceOptions& options, DeviceStats& stats, uint32_t seed);
+  ~SimDevice();
+
+  void start(long nowMs);
+  bool wantsPoll() const;
+  pollfd pollFd() const;
+  void handlePoll(short revents, long nowMs);
+  void tick(long nowMs);
+  long nextDeadlineMs() const;
+  bool isOpen() const;
+
+private:
+  enum State { Idle, Connecting, Handshake, Open };
+
+  void connect(long nowMs);
+  void disconnect(long nowMs);
+  bool readSocket();
+  bool flush();
+  void handleFrames(long nowMs);
+  void inspectPayload(const std::string& payload);
+  void send(const std::string& bytes, long nowMs);
+
+  DeviceOptions options;
+  DeviceStats& stats;
+  std::mt19937 rng;
+  State state = Idle;
+  int fd = -1;
+  std::string in;
+  std::string out;
+  std::string key;
+  long nextAttemptMs = 0;
+  long backoffMs = 1000;
+  long lastPingMs = 0;
+  bool everConnected = false;
+  uint32_t lastMessageId = 0;
+};
+
+}
+
+#endif // FEEDSIM_SIMDEVICE_H
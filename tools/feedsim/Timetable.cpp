@@ -0,0 +1,193 @@
+#include "Timetable.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace feedsim {
+
+namespace {
+// The CSV has no route column, so synthetic service is guessed from the
+// stop_id prefix. Good enough to light plausible colours on the map.
+std::vector<std::string> routesForStop(const std::string& stopId) {
+  switch (stopId.empty() ? '?' : stopId[0]) {
+    case '1': return {"1"};
+    case '2': return {"2", "3"};
+    case '3': return {"3"};
+    case '4': return {"4", "5"};
+    case '5': return {"5"};
+    case '6': return {"6"};
+    case '7': return {"7"};
+    case '9': return {"GS"};
+    case 'A': return {"A", "C"};
+    case 'B': return {"B", "D"};
+    case 'D': return {"D", "B"};
+    case 'E': return {"E"};
+    case 'F': return {"F"};
+    case 'G': return {"G"};
+    case 'H': return {"A", "H"};
+    case 'J': return {"J", "Z"};
+    case 'L': return {"L"};
+    case 'M': return {"M"};
+    case 'N': return {"N", "W"};
+    case 'Q': return {"Q"};
+    case 'R': return {"R", "W"};
+    case 'S': return {"SI"};
+    default: return {};
+  }
+}
+
+uint32_t hashString(const std::string& s) {
+  uint32_t h = 2166136261u;
+  for (char c : s) h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+  return h;
+}
+}
+
+std::string formatFeedTime(time_t t) {
+  struct tm tm;
+  localtime_r(&t, &tm);
+  char buf[40];
+  size_t n = strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S%z", &tm);
+  // MTAPI emits isoformat() offsets with a colon: -04:00
+  std::string out(buf, n);
+  if (out.size() >= 5) out.insert(out.size() - 2, ":");
+  return out;
+}
+
+bool Timetable::loadStations(const std::string& csvPath) {
+  std::ifstream in(csvPath);
+  if (!in) return false;
+
+  std::string line;
+  std::getline(in, line);  // header
+  std::set<std::string> seen;
+  while (std::getline(in, line)) {
+    std::string stopId = line.substr(0, line.find(','));
+    if (stopId.empty() || stopId == "non" || !seen.insert(stopId).second) continue;
+    stations.push_back({stopId, routesForStop(stopId)});
+  }
+  return !stations.empty();
+}
+
+// Scenario lines: <offset_seconds> <stop_id> <N|S> <route>
+// The scenario repeats one minute after its last arrival.
+bool Timetable::loadScenario(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) return false;
+
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    ScheduledArrival arrival;
+    std::string stopId;
+    if (!(fields >> arrival.offset >> stopId >> arrival.direction >> arrival.route)) continue;
+    scenario[stopId].push_back(arrival);
+    scenarioPeriod = std::max(scenarioPeriod, arrival.offset + 60);
+  }
+  for (auto& entry : scenario) {
+    std::sort(entry.second.begin(), entry.second.end(),
+              [](const ScheduledArrival& a, const ScheduledArrival& b) { return a.offset < b.offset; });
+  }
+  return !scenario.empty();
+}
+
+void Timetable::setStart(time_t value) {
+  start = value;
+}
+
+size_t Timetable::stationCount() const {
+  return stations.size();
+}
+
+std::string Timetable::buildPayload(time_t now, const FeedOptions& options) const {
+  std::string out;
+  out.reserve(stations.size() * 600 + options.padBytes + 64);
+  out += "{\"data\":[";
+
+  size_t limit = options.stationLimit ? std::min(options.stationLimit, stations.size()) : stations.size();
+  for (size_t i = 0; i < limit; ++i) {
+    const StationInfo& station = stations[i];
+    if (i > 0) out += ',';
+    out += "{\"id\":\"";
+    out += station.stopId;
+    out += "\"";
+    appendDirection(out, station, 'N', now, options);
+    appendDirection(out, station, 'S', now, options);
+    out += '}';
+  }
+  out += ']';
+
+  if (options.padBytes > 0) {
+    out += ",\"pad\":\"";
+    out.append(options.padBytes, 'x');
+    out += '"';
+  }
+  out += '}';
+  return out;
+}
+
+void Timetable::appendDirection(std::string& out, const StationInfo& station, char direction,
+                                time_t now, const FeedOptions& options) const {
+  std::vector<std::pair<time_t, const std::string*>> arrivals;
+  time_t until = now + options.maxMinutes * 60;
+  if (scenario.empty()) {
+    syntheticArrivals(station, direction, now, until, arrivals);
+  } else {
+    scenarioArrivals(station, direction, now, until, arrivals);
+  }
+  std::sort(arrivals.begin(), arrivals.end());
+  if (arrivals.size() > static_cast<size_t>(options.maxTrains)) arrivals.resize(options.maxTrains);
+
+  out += ",\"";
+  out += direction;
+  out += "\":[";
+  for (size_t i = 0; i < arrivals.size(); ++i) {
+    if (i > 0) out += ',';
+    out += "{\"route\":\"";
+    out += *arrivals[i].second;
+    out += "\",\"time\":\"";
+    out += formatFeedTime(arrivals[i].first);
+    out += "\"}";
+  }
+  out += ']';
+}
+
+// Each route runs a fixed headway of 4-12 minutes with a per-station phase,
+// southbound offset by half a headway, so successive payloads are stable
+// and trains march along the line.
+void Timetable::syntheticArrivals(const StationInfo& station, char direction, time_t now, time_t until,
+                                  std::vector<std::pair<time_t, const std::string*>>& out) const {
+  for (const std::string& route : station.routes) {
+    uint32_t h = hashString(route);
+    long headway = 240 + (h % 9) * 60;
+    long phase = (hashString(station.stopId) + h) % headway;
+    if (direction == 'S') phase = (phase + headway / 2) % headway;
+
+    // Include trains up to one arrival window in the past, as MTAPI does.
+    long first = now - 30 - phase;
+    time_t t = now - 30 + ((headway - first % headway) % headway);
+    for (; t <= until; t += headway) out.emplace_back(t, &route);
+  }
+}
+
+void Timetable::scenarioArrivals(const StationInfo& station, char direction, time_t now, time_t until,
+                                 std::vector<std::pair<time_t, const std::string*>>& out) const {
+  auto it = scenario.find(station.stopId);
+  if (it == scenario.end() || scenarioPeriod <= 0) return;
+
+  long cycle = (now - 30 - start) / scenarioPeriod;
+  for (long c = std::max(0L, cycle); ; ++c) {
+    time_t cycleStart = start + c * scenarioPeriod;
+    if (cycleStart > until) break;
+    for (const ScheduledArrival& arrival : it->second) {
+      time_t t = cycleStart + arrival.offset;
+      if (arrival.direction != direction || t < now - 30 || t > until) continue;
+      out.emplace_back(t, &arrival.route);
+    }
+  }
+}
+
+}
@@ -0,0 +1,58 @@
+#ifndef FEEDSIM_TIMETABLE_H
+#define FEEDSIM_TIMETABLE_H
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace feedsim {
+
+struct FeedOptions {
+  int maxTrains = 10;        // per station and direction, like MTAPI's MAX_TRAINS
+  int maxMinutes = 30;       // look-ahead, like MTAPI's MAX_MINUTES
+  size_t stationLimit = 0;   // 0 = every station in the CSV
+  size_t padBytes = 0;       // extra filler per message to reach a target size
+};
+
+// Produces the JSON the firmware's MtaManager::parseData() consumes:
+//   {"data":[{"id":"A33","N":[{"route":"A","time":"2025-09-27T14:23:37-04:00"}],"S":[...]}]}
+// FeedServer adds the msg_id/feed_ms/sent_ms trace fields ahead of "data".
+// from either synthetic per-route headways or a scenario file.
+class Timetable {
+public:
+  bool loadStations(const std::string& csvPath);
+  bool loadScenario(const std::string& path);
+  void setStart(time_t start);
+  size_t stationCount() const;
+  std::string buildPayload(time_t now, const FeedOptions& options) const;
+
+private:
+  struct StationInfo {
+    std::string stopId;
+    std::vector<std::string> routes;
+  };
+  struct ScheduledArrival {
+    long offset;       // seconds after start
+    char direction;    // 'N' or 'S'
+    std::string route;
+  };
+
+  void appendDirection(std::string& out, const StationInfo& station, char direction,
+                       time_t now, const FeedOptions& options) const;
+  void syntheticArrivals(const StationInfo& station, char direction, time_t now, time_t until,
+                         std::vector<std::pair<time_t, const std::string*>>& out) const;
+  void scenarioArrivals(const StationInfo& station, char direction, time_t now, time_t until,
+                        std::vector<std::pair<time_t, const std::string*>>& out) const;
+
+  std::vector<StationInfo> stations;
+  std::map<std::string, std::vector<ScheduledArrival>> scenario;
+  long scenarioPeriod = 0;
+  time_t start = 0;
+};
+
+std::string formatFeedTime(time_t t);
+
+}
+
+#endif // FEEDSIM_TIMETABLE_H
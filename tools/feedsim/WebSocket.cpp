@@ -0,0 +1,182 @@
+#include "WebSocket.h"
+#include <cstring>
+#include <random>
+#include <strings.h>
+
+namespace feedsim {
+
+namespace {
+uint32_t rotl(uint32_t x, int n) {
+  return (x << n) | (x >> (32 - n));
+}
+
+std::mt19937& maskRng() {
+  static std::mt19937 rng(std::random_device{}());
+  return rng;
+}
+}
+
+std::string base64Encode(const uint8_t* data, size_t length) {
+  static const char kTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  out.reserve((length + 2) / 3 * 4);
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t n = data[i] << 16;
+    if (i + 1 < length) n |= data[i + 1] << 8;
+    if (i + 2 < length) n |= data[i + 2];
+    out += kTable[(n >> 18) & 63];
+    out += kTable[(n >> 12) & 63];
+    out += i + 1 < length ? kTable[(n >> 6) & 63] : '=';
+    out += i + 2 < length ? kTable[n & 63] : '=';
+  }
+  return out;
+}
+
+void sha1(const uint8_t* data, size_t length, uint8_t digest[20]) {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+  std::string msg(reinterpret_cast<const char*>(data), length);
+  msg += static_cast<char>(0x80);
+  while (msg.size() % 64 != 56) msg += '\0';
+  uint64_t bits = static_cast<uint64_t>(length) * 8;
+  for (int i = 7; i >= 0; --i) msg += static_cast<char>((bits >> (i * 8)) & 0xFF);
+
+  for (size_t chunk = 0; chunk < msg.size(); chunk += 64) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+      const uint8_t* p = reinterpret_cast<const uint8_t*>(msg.data() + chunk + i * 4);
+      w[i] = (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+    }
+    for (int i = 16; i < 80; ++i) w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; ++i) {
+      uint32_t f, k;
+      if (i < 20) {
+        f = (b & c) | (~b & d);
+        k = 0x5A827999;
+      } else if (i < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ED9EBA1;
+      } else if (i < 60) {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8F1BBCDC;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xCA62C1D6;
+      }
+      uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = rotl(b, 30);
+      b = a;
+      a = temp;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    digest[i * 4] = h[i] >> 24;
+    digest[i * 4 + 1] = h[i] >> 16;
+    digest[i * 4 + 2] = h[i] >> 8;
+    digest[i * 4 + 3] = h[i];
+  }
+}
+
+std::string acceptKey(const std::string& clientKey) {
+  std::string input = clientKey + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+  uint8_t digest[20];
+  sha1(reinterpret_cast<const uint8_t*>(input.data()), input.size(), digest);
+  return base64Encode(digest, sizeof(digest));
+}
+
+std::string encodeFrame(Opcode opcode, const char* data, size_t length, bool mask) {
+  std::string frame;
+  frame.reserve(length + 14);
+  frame += static_cast<char>(0x80 | opcode);
+
+  uint8_t maskBit = mask ? 0x80 : 0;
+  if (length < 126) {
+    frame += static_cast<char>(maskBit | length);
+  } else if (length <= 0xFFFF) {
+    frame += static_cast<char>(maskBit | 126);
+    frame += static_cast<char>((length >> 8) & 0xFF);
+    frame += static_cast<char>(length & 0xFF);
+  } else {
+    frame += static_cast<char>(maskBit | 127);
+    for (int i = 7; i >= 0; --i) frame += static_cast<char>((static_cast<uint64_t>(length) >> (i * 8)) & 0xFF);
+  }
+
+  if (!mask) {
+    frame.append(data, length);
+    return frame;
+  }
+
+  uint8_t key[4];
+  uint32_t r = maskRng()();
+  memcpy(key, &r, 4);
+  frame.append(reinterpret_cast<const char*>(key), 4);
+  size_t start = frame.size();
+  frame.append(data, length);
+  for (size_t i = 0; i < length; ++i) frame[start + i] ^= key[i & 3];
+  return frame;
+}
+
+long decodeFrame(const char* buf, size_t length, Frame& out) {
+  if (length < 2) return 0;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(buf);
+  out.fin = (p[0] & 0x80) != 0;
+  out.opcode = static_cast<Opcode>(p[0] & 0x0F);
+  bool masked = (p[1] & 0x80) != 0;
+  uint64_t payloadLength = p[1] & 0x7F;
+  size_t pos = 2;
+
+  if (payloadLength == 126) {
+    if (length < pos + 2) return 0;
+    payloadLength = (p[2] << 8) | p[3];
+    pos += 2;
+  } else if (payloadLength == 127) {
+    if (length < pos + 8) return 0;
+    payloadLength = 0;
+    for (int i = 0; i < 8; ++i) payloadLength = (payloadLength << 8) | p[pos + i];
+    pos += 8;
+  }
+  if (payloadLength > (64U << 20)) return -1;
+
+  uint8_t key[4] = {0, 0, 0, 0};
+  if (masked) {
+    if (length < pos + 4) return 0;
+    memcpy(key, p + pos, 4);
+    pos += 4;
+  }
+  if (length < pos + payloadLength) return 0;
+
+  out.payload.assign(buf + pos, payloadLength);
+  if (masked) {
+    for (size_t i = 0; i < payloadLength; ++i) out.payload[i] ^= key[i & 3];
+  }
+  return static_cast<long>(pos + payloadLength);
+}
+
+std::string headerValue(const std::string& head, const char* name) {
+  size_t nameLength = strlen(name);
+  size_t lineStart = 0;
+  while (lineStart < head.size()) {
+    size_t lineEnd = head.find("\r\n", lineStart);
+    if (lineEnd == std::string::npos) lineEnd = head.size();
+    if (lineEnd - lineStart > nameLength && head[lineStart + nameLength] == ':' &&
+        strncasecmp(head.c_str() + lineStart, name, nameLength) == 0) {
+      size_t valueStart = lineStart + nameLength + 1;
+      while (valueStart < lineEnd && head[valueStart] == ' ') ++valueStart;
+      return head.substr(valueStart, lineEnd - valueStart);
+    }
+    lineStart = lineEnd + 2;
+  }
+  return "";
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef FEEDSIM_WEBSOCKET_H
+#define FEEDSIM_WEBSOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Minimal RFC 6455 helpers: enough for the /ws text stream the firmware
+// consumes plus ping/pong/close and binary frames from devices.
+namespace feedsim {
+
+enum Opcode : uint8_t {
+  OpContinuation = 0x0,
+  OpText = 0x1,
+  OpBinary = 0x2,
+  OpClose = 0x8,
+  OpPing = 0x9,
+  OpPong = 0xA
+};
+
+struct Frame {
+  Opcode opcode = OpText;
+  bool fin = true;
+  std::string payload;
+};
+
+std::string base64Encode(const uint8_t* data, size_t length);
+void sha1(const uint8_t* data, size_t length, uint8_t digest[20]);
+std::string acceptKey(const std::string& clientKey);
+
+// Client-to-server frames must be masked, server-to-client frames must not.
+std::string encodeFrame(Opcode opcode, const char* data, size_t length, bool mask);
+
+// Decodes one frame from the front of buf. Returns bytes consumed, 0 when
+// more data is needed, or -1 on a protocol error.
+long decodeFrame(const char* buf, size_t length, Frame& out);
+
+// Value of an HTTP header in a raw request/response, case-insensitive name.
+std::string headerValue(const std::string& head, const char* name);
+
+}
+
+#endif // FEEDSIM_WEBSOCKET_H
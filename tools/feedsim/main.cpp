@@ -0,0 +1,301 @@
+// feedsim: native stand-in for the MTAPI /ws feed plus a load generator of
+// simulated maps, for exercising ingestion and reconnect logic offline.
+//
+// Simulated devices run received payloads through the firmware's own parser,
+// built for the host over tools/hostshim. ArduinoJson comes from PlatformIO's
+// library folder, so run `pio pkg install` once, then build from the repo root:
+//   JSON=.pio/libdeps/arduino_nano_esp32/ArduinoJson/src
+//   FIRMWARE=$(ls src/*.cpp | grep -v -e main.cpp -e NetworkManager.cpp)
+//   g++ -std=gnu++17 -O2 -Iinclude -Itools/hostshim -I$JSON tools/feedsim/*.cpp tools/hostshim/*.cpp $FIRMWARE -o feedsim
+//
+// Examples:
+//   ./feedsim --csv scripts/stations.csv                     # serve synthetic service on :5000
+//   ./feedsim --clients 300 --interval-ms 1000 --drop-prob 0.01   # serve and load-test in one process
+//   ./feedsim --no-server --target 10.0.0.5:5000 --clients 200  # load-test a real MTAPI server
+//   ./feedsim --mirror map.ppm                               # also rebuild what the map shows
+
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "FeedServer.h"
+#include "HostFirmware.h"
+#include "Metrics.h"
+#include "SimDevice.h"
+#include "Timetable.h"
+
+using namespace feedsim;
+
+namespace {
+
+volatile sig_atomic_t stopRequested = 0;
+
+void onSignal(int) {
+  stopRequested = 1;
+}
+
+long nowMs() {
+  using namespace std::chrono;
+  return static_cast<long>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "feed:\n"
+          "  --csv PATH              stations CSV (default scripts/stations.csv)\n"
+          "  --scenario PATH         '<offset_s> <stop_id> <N|S> <route>' lines instead of synthetic service\n"
+          "  --payload PATH          replay a captured JSON payload verbatim\n"
+          "  --max-trains N          arrivals per station and direction (default 10)\n"
+          "  --minutes N             look-ahead in minutes (default 30)\n"
+          "  --stations N            only the first N stations\n"
+          "  --pad BYTES             filler appended to each message\n"
+          "server:\n"
+          "  --port N                listen port (default 5000)\n"
+          "  --interval-ms N         broadcast interval (default 10000)\n"
+          "  --drop-prob P           chance per peer per broadcast of dropping the connection\n"
+          "  --mirror PATH           ask maps to stream their LEDs; write frames to PATH (PPM) or '-' (terminal)\n"
+          "  --mirror-width N        LEDs per row in the mirror view (default 50)\n"
+          "  --no-server             only run simulated devices\n"
+          "load generator:\n"
+          "  --clients N             simulated devices (default 0)\n"
+          "  --target HOST:PORT      where devices connect (default this server)\n"
+          "  --client-drop-prob P    chance per received message of a device dropping\n"
+          "  --no-ingest             don't run device 0's payloads through the firmware parser\n"
+          "general:\n"
+          "  --report-sec N          stats interval (default 5)\n"
+          "  --duration-sec N        exit after N seconds\n",
+          argv0);
+}
+
+}
+
+int main(int argc, char** argv) {
+  FeedOptions feed;
+  ServerOptions server;
+  DeviceOptions device;
+  std::string csvPath = "scripts/stations.csv";
+  std::string scenarioPath;
+  bool runServer = true;
+  bool targetSet = false;
+  size_t clientCount = 0;
+  long reportMs = 5000;
+  long durationMs = 0;
+
+  enum {
+    OptCsv = 1, OptScenario, OptPayload, OptMaxTrains, OptMinutes, OptStations, OptPad,
+    OptPort, OptInterval, OptDrop, OptNoServer, OptClients, OptTarget, OptClientDrop,
+    OptNoIngest, OptReport, OptDuration, OptMirror, OptMirrorWidth, OptHelp
+  };
+  static const option longOptions[] = {
+    {"csv", required_argument, nullptr, OptCsv},
+    {"scenario", required_argument, nullptr, OptScenario},
+    {"payload", required_argument, nullptr, OptPayload},
+    {"max-trains", required_argument, nullptr, OptMaxTrains},
+    {"minutes", required_argument, nullptr, OptMinutes},
+    {"stations", required_argument, nullptr, OptStations},
+    {"pad", required_argument, nullptr, OptPad},
+    {"port", required_argument, nullptr, OptPort},
+    {"interval-ms", required_argument, nullptr, OptInterval},
+    {"drop-prob", required_argument, nullptr, OptDrop},
+    {"no-server", no_argument, nullptr, OptNoServer},
+    {"clients", required_argument, nullptr, OptClients},
+    {"target", required_argument, nullptr, OptTarget},
+    {"client-drop-prob", required_argument, nullptr, OptClientDrop},
+    {"no-ingest", no_argument, nullptr, OptNoIngest},
+    {"report-sec", required_argument, nullptr, OptReport},
+    {"duration-sec", required_argument, nullptr, OptDuration},
+    {"mirror", required_argument, nullptr, OptMirror},
+    {"mirror-width", required_argument, nullptr, OptMirrorWidth},
+    {"help", no_argument, nullptr, OptHelp},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "", longOptions, nullptr)) != -1) {
+    switch (opt) {
+      case OptCsv: csvPath = optarg; break;
+      case OptScenario: scenarioPath = optarg; break;
+      case OptPayload: server.replayPath = optarg; break;
+      case OptMaxTrains: feed.maxTrains = atoi(optarg); break;
+      case OptMinutes: feed.maxMinutes = atoi(optarg); break;
+      case OptStations: feed.stationLimit = strtoul(optarg, nullptr, 10); break;
+      case OptPad: feed.padBytes = strtoul(optarg, nullptr, 10); break;
+      case OptPort: server.port = static_cast<uint16_t>(atoi(optarg)); break;
+      case OptInterval: server.intervalMs = atol(optarg); break;
+      case OptDrop: server.dropProbability = atof(optarg); break;
+      case OptNoServer: runServer = false; break;
+      case OptClients: clientCount = strtoul(optarg, nullptr, 10); break;
+      case OptTarget: {
+        std::string target = optarg;
+        size_t colon = target.rfind(':');
+        device.host = target.substr(0, colon);
+        if (colon != std::string::npos) device.port = static_cast<uint16_t>(atoi(target.c_str() + colon + 1));
+        targetSet = true;
+        break;
+      }
+      case OptClientDrop: device.dropProbability = atof(optarg); break;
+      case OptNoIngest: device.ingest = false; break;
+      case OptReport: reportMs = atol(optarg) * 1000; break;
+      case OptDuration: durationMs = atol(optarg) * 1000; break;
+      case OptMirror: server.mirrorPath = optarg; break;
+      case OptMirrorWidth: server.mirrorWidth = strtoul(optarg, nullptr, 10); break;
+      default:
+        usage(argv[0]);
+        return opt == OptHelp ? 0 : 2;
+    }
+  }
+  if (!targetSet) device.port = server.port;
+
+  // Feed times are local New York time, as the firmware interprets them.
+  setenv("TZ", "EST5EDT,M3.2.0/2,M11.1.0/2", 1);
+  tzset();
+  signal(SIGPIPE, SIG_IGN);
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+
+  Timetable timetable;
+  timetable.setStart(time(nullptr));
+  std::unique_ptr<FeedServer> feedServer;
+  if (runServer) {
+    if (server.replayPath.empty() && !timetable.loadStations(csvPath)) {
+      fprintf(stderr, "cannot load stations from %s\n", csvPath.c_str());
+      return 1;
+    }
+    if (!scenarioPath.empty() && !timetable.loadScenario(scenarioPath)) {
+      fprintf(stderr, "cannot load scenario %s\n", scenarioPath.c_str());
+      return 1;
+    }
+    feedServer = std::make_unique<FeedServer>(timetable, feed, server);
+    if (!feedServer->listen()) return 1;
+    printf("[feedsim] serving ws://0.0.0.0:%u/ws, %zu stations, every %ld ms\n",
+           server.port, timetable.stationCount(), server.intervalMs);
+  }
+
+  if (clientCount > 0 && device.ingest) hostshim::setupFirmware();
+
+  DeviceStats deviceStats;
+  std::vector<std::unique_ptr<SimDevice>> devices;
+  long start = nowMs();
+  for (size_t i = 0; i < clientCount; ++i) {
+    // One firmware map per process: only the first device ingests.
+    DeviceOptions options = device;
+    options.ingest = device.ingest && i == 0;
+    devices.push_back(std::make_unique<SimDevice>(options, deviceStats, static_cast<uint32_t>(i + 1)));
+    devices.back()->start(start);
+  }
+  if (clientCount > 0) {
+    printf("[feedsim] %zu simulated devices -> ws://%s:%u/ws (%s)\n", clientCount, device.host.c_str(), device.port,
+           !device.ingest ? "all network-only"
+           : clientCount == 1 ? "device 0 ingests"
+                              : "device 0 ingests, the rest are network-only");
+  }
+
+  long nextReport = start + reportMs;
+  std::vector<pollfd> fds;
+  std::vector<size_t> deviceIndex;
+  while (!stopRequested && (durationMs == 0 || nowMs() - start < durationMs)) {
+    fds.clear();
+    deviceIndex.clear();
+    if (feedServer) feedServer->collectPollFds(fds);
+    size_t deviceStart = fds.size();
+    for (size_t i = 0; i < devices.size(); ++i) {
+      if (!devices[i]->wantsPoll()) continue;
+      fds.push_back(devices[i]->pollFd());
+      deviceIndex.push_back(i);
+    }
+
+    long now = nowMs();
+    long deadline = nextReport;
+    if (feedServer) deadline = std::min(deadline, feedServer->nextDeadlineMs());
+    for (auto& d : devices) deadline = std::min(deadline, d->nextDeadlineMs());
+    int timeout = static_cast<int>(std::max(0L, std::min(deadline - now, 1000L)));
+
+    if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+      perror("poll");
+      break;
+    }
+
+    now = nowMs();
+    if (feedServer) feedServer->handlePoll(fds, 0, now);
+    for (size_t i = 0; i < deviceIndex.size(); ++i) {
+      devices[deviceIndex[i]]->handlePoll(fds[deviceStart + i].revents, now);
+    }
+    for (auto& d : devices) d->tick(now);
+
+    if (now >= nextReport) {
+      if (feedServer) {
+        const ServerStats& s = feedServer->stats();
+        printf("[server] peers=%zu conns=%llu sent=%llu msgs %.1f MB payload=%zu B build=%.2f ms "
+               "drops=%llu slow=%llu pings=%llu\n",
+               feedServer->openPeers(),
+               static_cast<unsigned long long>(s.connections),
+               static_cast<unsigned long long>(s.messagesSent),
+               s.bytesSent / 1e6,
+               s.lastPayloadBytes,
+               s.lastBuildMs,
+               static_cast<unsigned long long>(s.injectedDrops),
+               static_cast<unsigned long long>(s.slowDrops),
+               static_cast<unsigned long long>(s.pingsAnswered));
+        if (const MirrorViewer* mirror = feedServer->mirrorViewer()) {
+          const MirrorStats& m = mirror->stats();
+          printf("[mirror] frames=%llu keys=%llu %.1f KB gaps=%llu errors=%llu decode max=%.1f us\n",
+                 static_cast<unsigned long long>(m.frames),
+                 static_cast<unsigned long long>(m.keyFrames),
+                 m.bytes / 1e3,
+                 static_cast<unsigned long long>(m.gaps),
+                 static_cast<unsigned long long>(m.errors),
+                 m.decodeUsMax);
+        }
+      }
+      if (!devices.empty()) {
+        size_t open = 0;
+        for (auto& d : devices) open += d->isOpen() ? 1 : 0;
+        const DeviceStats& d = deviceStats;
+        printf("[devices] open=%zu/%zu attempts=%llu reconnects=%llu msgs=%llu %.1f MB "
+               "stations=%llu arrivals=%llu errors=%llu drops=%llu closes=%llu pongs=%llu "
+               "missed=%llu latency avg=%.1f max=%.1f ms\n",
+               open, devices.size(),
+               static_cast<unsigned long long>(d.connectAttempts),
+               static_cast<unsigned long long>(d.reconnects),
+               static_cast<unsigned long long>(d.messages),
+               d.bytes / 1e6,
+               static_cast<unsigned long long>(d.stations),
+               static_cast<unsigned long long>(d.arrivals),
+               static_cast<unsigned long long>(d.parseErrors),
+               static_cast<unsigned long long>(d.injectedDrops),
+               static_cast<unsigned long long>(d.remoteCloses),
+               static_cast<unsigned long long>(d.pongs),
+               static_cast<unsigned long long>(d.missedMessages),
+               d.latencySamples ? d.latencySumMs / d.latencySamples : 0.0,
+               d.latencyMaxMs);
+      }
+      if (!devices.empty() && device.ingest) {
+        const DurationStat& parse = Metrics::parseTime;
+        printf("[ingest device 0] parsed=%lu skipped=%lu errors=%lu stations updated=%lu skipped=%lu rejected=%lu "
+               "trains added=%lu replaced=%lu purged=%lu promoted=%lu parse avg=%.2f max=%.2f ms\n",
+               static_cast<unsigned long>(parse.count),
+               static_cast<unsigned long>(Metrics::messagesSkipped),
+               static_cast<unsigned long>(Metrics::parseErrors),
+               static_cast<unsigned long>(Metrics::stationsUpdated),
+               static_cast<unsigned long>(Metrics::stationsSkipped),
+               static_cast<unsigned long>(Metrics::stationsRejected),
+               static_cast<unsigned long>(Metrics::trainsAdded),
+               static_cast<unsigned long>(Metrics::trainsReplaced),
+               static_cast<unsigned long>(Metrics::trainsPurged),
+               static_cast<unsigned long>(Metrics::trainsPromoted),
+               parse.count ? parse.sumUs / 1e3 / parse.count : 0.0,
+               parse.maxUs / 1e3);
+      }
+      fflush(stdout);
+      nextReport = now + reportMs;
+    }
+  }
+  return 0;
+}
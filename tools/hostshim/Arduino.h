@@ -0,0 +1,95 @@
+#ifndef HOSTSHIM_ARDUINO_H
+#define HOSTSHIM_ARDUINO_H
+
+// Just enough of the Arduino-ESP32 core to build the firmware's logic on a
+// host. Pins, interrupts and the heap report are no-ops; time comes from the
+// host clock. See README.md in this directory.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+#define RTC_NOINIT_ATTR
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define FALLING 0x02
+#define CHANGE 0x03
+#define LED_BUILTIN 0
+#define ARDUINO_RUNNING_CORE 1
+
+unsigned long millis();
+unsigned long micros();
+inline void delay(unsigned long) {}
+inline void yield() {}
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int digitalRead(int) { return HIGH; }
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void configTime(long, int, const char*, const char* = nullptr, const char* = nullptr) {}
+
+class String {
+public:
+    String() = default;
+    String(const char* s) : s(s ? s : "") {}
+    const char* c_str() const { return s.c_str(); }
+    size_t length() const { return s.size(); }
+    String& operator+=(const char* more) { s += more; return *this; }
+    String& operator+=(const String& more) { s += more.s; return *this; }
+private:
+    std::string s;
+};
+
+// Output goes to stderr, so it doesn't mix with a tool's own report.
+class Print {
+public:
+    size_t print(const char* s) { return fputs(s, stderr) < 0 ? 0 : strlen(s); }
+    size_t println(const char* s = "") { return print(s) + print("\n"); }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        int n = vfprintf(stderr, format, args);
+        va_end(args);
+        return n < 0 ? 0 : static_cast<size_t>(n);
+    }
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+};
+extern HardwareSerial Serial;
+
+// The host has no fixed heap to report; MemoryPolicy simulates the tiers.
+class EspClass {
+public:
+    uint32_t getHeapSize() { return 0; }
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getMinFreeHeap() { return 0; }
+    uint32_t getMaxAllocHeap() { return 0; }
+    [[noreturn]] void restart() { abort(); }
+};
+extern EspClass ESP;
+
+#endif // HOSTSHIM_ARDUINO_H
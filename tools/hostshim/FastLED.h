@@ -0,0 +1,37 @@
+#ifndef HOSTSHIM_FASTLED_H
+#define HOSTSHIM_FASTLED_H
+
+#include <Arduino.h>
+
+// Pixels only: show() drives nothing.
+struct CRGB {
+    uint8_t r = 0, g = 0, b = 0;
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000, Red = 0xFF0000, Orange = 0xFFA500, White = 0xFFFFFF
+    };
+
+    CRGB() = default;
+    CRGB(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
+    CRGB(uint32_t c) : r(c >> 16), g(c >> 8), b(c) {}
+    CRGB(HTMLColorCode c) : r(c >> 16), g(c >> 8), b(c) {}
+    bool operator==(const CRGB& o) const { return r == o.r && g == o.g && b == o.b; }
+    bool operator!=(const CRGB& o) const { return !(*this == o); }
+};
+
+#define WS2812B 0
+#define GRB 0
+
+class CFastLED {
+public:
+    template <int Type, int Pin, int Order>
+    CFastLED& addLeds(CRGB*, int) { return *this; }
+    void setBrightness(uint8_t) {}
+    void setMaxRefreshRate(uint16_t, bool = false) {}
+    void show() {}
+};
+extern CFastLED FastLED;
+
+#define EVERY_N_SECONDS(n) if (false)
+
+#endif // HOSTSHIM_FASTLED_H
@@ -0,0 +1,48 @@
+#include "HostFirmware.h"
+#include <vector>
+#include "AllocTracker.h"
+#include "ArrivalHistory.h"
+#include "DisplayMode.h"
+#include "FlightRecorder.h"
+#include "HorizonStore.h"
+#include "LEDManager.h"
+#include "LatencyTracer.h"
+#include "MTAManager.h"
+#include "MemoryPolicy.h"
+#include "StationMap.h"
+#include "StationMapImage.h"
+
+namespace hostshim {
+
+void setupFirmware() {
+  FlightRecorder::begin();
+  AllocTracker::begin();
+  MemoryPolicy::begin();
+  if (!StationMapImage::load()) StationMap::useGenerated();
+  HorizonStore::begin();
+  MtaManager::begin();
+  LEDManager::initializeLEDs();
+  ArrivalHistory::begin();
+  DisplayMode::begin();
+}
+
+void deliver(const char* payload, size_t length) {
+  // Reused, like the WebSocket library's receive buffer.
+  static std::vector<char> buffer;
+  LatencyTracer::received();
+  AllocTracker::Scope scope(AllocTracker::Parse);
+  buffer.assign(payload, payload + length);
+  MtaManager::parseData(buffer.data(), buffer.size());
+}
+
+void runArrivals() {
+  AllocTracker::Scope scope(AllocTracker::Arrivals);
+  if (MtaManager::isRefreshDue()) {
+    MtaManager::purgeExpiredTrains();
+    MtaManager::checkArrivals();
+  } else if (DisplayMode::needsRender()) {
+    MtaManager::renderArrivals();
+  }
+}
+
+}
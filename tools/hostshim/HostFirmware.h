@@ -0,0 +1,24 @@
+#ifndef HOSTSHIM_HOSTFIRMWARE_H
+#define HOSTSHIM_HOSTFIRMWARE_H
+
+#include <cstddef>
+
+// The firmware's setup() without WiFi, the WebSocket or the HTTP listener:
+// station map, memory tiers, horizon store, parser, LEDs, arrival history
+// and display modes. Link with every src/*.cpp except main.cpp and
+// NetworkManager.cpp.
+namespace hostshim {
+
+void setupFirmware();
+
+// One message as NetworkManager hands it over: a mutable copy of payload
+// goes through MtaManager::parseData() under the Parse allocation scope.
+void deliver(const char* payload, size_t length);
+
+// The arrivals phase of loop(): purge and checkArrivals() when a refresh is
+// due, otherwise a render if the display asks for one.
+void runArrivals();
+
+}
+
+#endif // HOSTSHIM_HOSTFIRMWARE_H
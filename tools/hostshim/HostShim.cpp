@@ -0,0 +1,36 @@
+#include <Arduino.h>
+#include <FastLED.h>
+#include <sys/time.h>
+#include <chrono>
+
+HardwareSerial Serial;
+EspClass ESP;
+CFastLED FastLED;
+
+namespace {
+const auto kStart = std::chrono::steady_clock::now();
+}
+
+unsigned long millis() {
+  using namespace std::chrono;
+  return static_cast<unsigned long>(duration_cast<milliseconds>(steady_clock::now() - kStart).count());
+}
+
+unsigned long micros() {
+  using namespace std::chrono;
+  return static_cast<unsigned long>(duration_cast<microseconds>(steady_clock::now() - kStart).count());
+}
+
+TickType_t xTaskGetTickCount() {
+  return static_cast<TickType_t>(millis());
+}
+
+// TimeManager disciplines the system clock to the feed. The host's clock
+// isn't ours to set, so its steps and slews are counted and dropped here.
+extern "C" int settimeofday(const struct timeval*, const struct timezone*) noexcept {
+  return 0;
+}
+
+extern "C" int adjtime(const struct timeval*, struct timeval*) noexcept {
+  return 0;
+}
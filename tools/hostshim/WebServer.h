@@ -0,0 +1,27 @@
+#ifndef HOSTSHIM_WEBSERVER_H
+#define HOSTSHIM_WEBSERVER_H
+
+#include <Arduino.h>
+
+// Handlers are registered and never called; nothing listens.
+enum HTTPMethod { HTTP_GET };
+#define CONTENT_LENGTH_UNKNOWN static_cast<size_t>(-1)
+
+class WebServer {
+public:
+    typedef void (*Handler)();
+
+    explicit WebServer(int) {}
+    void on(const char*, HTTPMethod, Handler) {}
+    void begin() {}
+    void handleClient() {}
+    bool hasArg(const char*) { return false; }
+    String arg(const char*) { return String(); }
+    void setContentLength(size_t) {}
+    void send(int, const char*, const char*) {}
+    void send(int, const char*, const String&) {}
+    void sendContent(const char*, size_t) {}
+    void sendContent(const char*) {}
+};
+
+#endif // HOSTSHIM_WEBSERVER_H
@@ -0,0 +1,9 @@
+#ifndef HOSTSHIM_ESP_SNTP_H
+#define HOSTSHIM_ESP_SNTP_H
+
+#include <sys/time.h>
+
+// Defined by the firmware; nothing calls it on the host.
+extern "C" void sntp_sync_time(struct timeval* tv);
+
+#endif // HOSTSHIM_ESP_SNTP_H
@@ -0,0 +1,23 @@
+#ifndef HOSTSHIM_FREERTOS_H
+#define HOSTSHIM_FREERTOS_H
+
+#include <cstdint>
+
+// One thread, no scheduler: task creation fails, waits return at once and
+// semaphores are always available.
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) static_cast<TickType_t>(ms)
+#define portTICK_PERIOD_MS 1
+
+#endif // HOSTSHIM_FREERTOS_H
@@ -0,0 +1,14 @@
+#ifndef HOSTSHIM_FREERTOS_QUEUE_H
+#define HOSTSHIM_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+// Nothing runs on another task, so queues are never created and receives
+// find nothing.
+typedef void* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t, UBaseType_t) { return nullptr; }
+inline BaseType_t xQueueOverwrite(QueueHandle_t, const void*) { return pdFALSE; }
+inline BaseType_t xQueueReceive(QueueHandle_t, void*, TickType_t) { return pdFALSE; }
+
+#endif // HOSTSHIM_FREERTOS_QUEUE_H
@@ -0,0 +1,17 @@
+#ifndef HOSTSHIM_FREERTOS_TASK_H
+#define HOSTSHIM_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+TickType_t xTaskGetTickCount();
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t,
+                                          TaskHandle_t*, BaseType_t) {
+    return pdFAIL;
+}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*) {}
+inline void portYIELD_FROM_ISR() {}
+
+#endif // HOSTSHIM_FREERTOS_TASK_H